@@ -0,0 +1,113 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/experiments/CMakeLists.txt"
+  "/root/repo/experiments/dot-product-db/CMakeLists.txt"
+  "/root/repo/experiments/dot-product/CMakeLists.txt"
+  "/root/repo/experiments/mac-check/CMakeLists.txt"
+  "/root/repo/experiments/ot-offline/CMakeLists.txt"
+  "/root/repo/experiments/preprocessing-converter/CMakeLists.txt"
+  "/root/repo/experiments/ring-gemm/CMakeLists.txt"
+  "/root/repo/experiments/secure-authentication/CMakeLists.txt"
+  "/root/repo/experiments/secure-com/CMakeLists.txt"
+  "/root/repo/src/networking/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBTargets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindOpenSSL.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/eigen3/cmake/Eigen3Config.cmake"
+  "/usr/share/eigen3/cmake/Eigen3ConfigVersion.cmake"
+  "/usr/share/eigen3/cmake/Eigen3Targets.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/networking/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/dot-product/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/dot-product-db/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/ring-gemm/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/preprocessing-converter/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/ot-offline/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/mac-check/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/secure-com/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "experiments/secure-authentication/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/bioauth-timer.dir/DependInfo.cmake"
+  "src/networking/CMakeFiles/bioauth-networking.dir/DependInfo.cmake"
+  "experiments/dot-product/CMakeFiles/dot_product_party_0.dir/DependInfo.cmake"
+  "experiments/dot-product/CMakeFiles/dot_product_party_1.dir/DependInfo.cmake"
+  "experiments/dot-product/CMakeFiles/dot_product_fake_offline.dir/DependInfo.cmake"
+  "experiments/dot-product-db/CMakeFiles/dot_product_db_party_0.dir/DependInfo.cmake"
+  "experiments/dot-product-db/CMakeFiles/dot_product_db_party_1.dir/DependInfo.cmake"
+  "experiments/dot-product-db/CMakeFiles/dot_product_db_offline_party_0.dir/DependInfo.cmake"
+  "experiments/dot-product-db/CMakeFiles/dot_product_db_offline_party_1.dir/DependInfo.cmake"
+  "experiments/ring-gemm/CMakeFiles/ring_gemm_benchmark.dir/DependInfo.cmake"
+  "experiments/preprocessing-converter/CMakeFiles/convert_preprocessing.dir/DependInfo.cmake"
+  "experiments/ot-offline/CMakeFiles/ot_offline_party_0.dir/DependInfo.cmake"
+  "experiments/ot-offline/CMakeFiles/ot_offline_party_1.dir/DependInfo.cmake"
+  "experiments/mac-check/CMakeFiles/mac_check_benchmark.dir/DependInfo.cmake"
+  "experiments/secure-com/CMakeFiles/secure_com_fss_lib.dir/DependInfo.cmake"
+  "experiments/secure-com/CMakeFiles/com_party_0.dir/DependInfo.cmake"
+  "experiments/secure-com/CMakeFiles/com_party_1.dir/DependInfo.cmake"
+  "experiments/secure-com/CMakeFiles/run_secure_com_party_0.dir/DependInfo.cmake"
+  "experiments/secure-com/CMakeFiles/run_secure_com_party_1.dir/DependInfo.cmake"
+  "experiments/secure-com/CMakeFiles/test_secure_com_complete.dir/DependInfo.cmake"
+  "experiments/secure-authentication/CMakeFiles/secure_authentication_fss_lib.dir/DependInfo.cmake"
+  "experiments/secure-authentication/CMakeFiles/secure_authentication_party_0.dir/DependInfo.cmake"
+  "experiments/secure-authentication/CMakeFiles/secure_authentication_party_1.dir/DependInfo.cmake"
+  "experiments/secure-authentication/CMakeFiles/run_secure_authentication_party_0.dir/DependInfo.cmake"
+  "experiments/secure-authentication/CMakeFiles/run_secure_authentication_party_1.dir/DependInfo.cmake"
+  "experiments/secure-authentication/CMakeFiles/test_secure_authentication_complete.dir/DependInfo.cmake"
+  )
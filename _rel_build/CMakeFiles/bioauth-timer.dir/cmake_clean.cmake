@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bioauth-timer.dir/src/utils/Timer.cpp.o"
+  "CMakeFiles/bioauth-timer.dir/src/utils/Timer.cpp.o.d"
+  "libbioauth-timer.a"
+  "libbioauth-timer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bioauth-timer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
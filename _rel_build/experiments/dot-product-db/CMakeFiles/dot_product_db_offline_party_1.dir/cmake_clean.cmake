@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dot_product_db_offline_party_1.dir/dot_product_db_offline_party_1.cpp.o"
+  "CMakeFiles/dot_product_db_offline_party_1.dir/dot_product_db_offline_party_1.cpp.o.d"
+  "dot_product_db_offline_party_1"
+  "dot_product_db_offline_party_1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dot_product_db_offline_party_1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
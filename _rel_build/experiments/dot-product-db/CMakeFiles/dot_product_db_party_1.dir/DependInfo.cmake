@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/experiments/dot-product-db/dot_product_db_party_1.cpp" "experiments/dot-product-db/CMakeFiles/dot_product_db_party_1.dir/dot_product_db_party_1.cpp.o" "gcc" "experiments/dot-product-db/CMakeFiles/dot_product_db_party_1.dir/dot_product_db_party_1.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/src/networking/CMakeFiles/bioauth-networking.dir/DependInfo.cmake"
+  "/root/repo/_rel_build/CMakeFiles/bioauth-timer.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dot_product_fake_offline.dir/dot_product_fake_offline.cpp.o"
+  "CMakeFiles/dot_product_fake_offline.dir/dot_product_fake_offline.cpp.o.d"
+  "dot_product_fake_offline"
+  "dot_product_fake_offline.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dot_product_fake_offline.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dot_product_party_0.dir/dot_product_party_0.cpp.o"
+  "CMakeFiles/dot_product_party_0.dir/dot_product_party_0.cpp.o.d"
+  "dot_product_party_0"
+  "dot_product_party_0.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dot_product_party_0.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
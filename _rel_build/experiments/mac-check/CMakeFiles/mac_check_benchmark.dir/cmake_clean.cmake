@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mac_check_benchmark.dir/mac_check_benchmark.cpp.o"
+  "CMakeFiles/mac_check_benchmark.dir/mac_check_benchmark.cpp.o.d"
+  "mac_check_benchmark"
+  "mac_check_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mac_check_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
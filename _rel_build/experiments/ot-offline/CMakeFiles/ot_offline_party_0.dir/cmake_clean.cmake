@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ot_offline_party_0.dir/ot_offline_party_0.cpp.o"
+  "CMakeFiles/ot_offline_party_0.dir/ot_offline_party_0.cpp.o.d"
+  "ot_offline_party_0"
+  "ot_offline_party_0.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ot_offline_party_0.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
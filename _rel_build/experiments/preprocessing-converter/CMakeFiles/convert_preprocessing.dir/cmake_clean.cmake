@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/convert_preprocessing.dir/convert_preprocessing.cpp.o"
+  "CMakeFiles/convert_preprocessing.dir/convert_preprocessing.cpp.o.d"
+  "convert_preprocessing"
+  "convert_preprocessing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/convert_preprocessing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ring_gemm_benchmark.dir/ring_gemm_benchmark.cpp.o"
+  "CMakeFiles/ring_gemm_benchmark.dir/ring_gemm_benchmark.cpp.o.d"
+  "ring_gemm_benchmark"
+  "ring_gemm_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ring_gemm_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/secure_authentication_fss_lib.dir/__/__/src/networking/fss-client.cpp.o"
+  "CMakeFiles/secure_authentication_fss_lib.dir/__/__/src/networking/fss-client.cpp.o.d"
+  "CMakeFiles/secure_authentication_fss_lib.dir/__/__/src/networking/fss-common.cpp.o"
+  "CMakeFiles/secure_authentication_fss_lib.dir/__/__/src/networking/fss-common.cpp.o.d"
+  "CMakeFiles/secure_authentication_fss_lib.dir/__/__/src/networking/fss-server.cpp.o"
+  "CMakeFiles/secure_authentication_fss_lib.dir/__/__/src/networking/fss-server.cpp.o.d"
+  "libsecure_authentication_fss_lib.a"
+  "libsecure_authentication_fss_lib.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/secure_authentication_fss_lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
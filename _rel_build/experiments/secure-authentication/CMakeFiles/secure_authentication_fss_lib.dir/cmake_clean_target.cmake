@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libsecure_authentication_fss_lib.a"
+)
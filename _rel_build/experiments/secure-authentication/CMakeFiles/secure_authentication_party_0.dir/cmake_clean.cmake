@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/secure_authentication_party_0.dir/secure_authentication_party_0.cpp.o"
+  "CMakeFiles/secure_authentication_party_0.dir/secure_authentication_party_0.cpp.o.d"
+  "secure_authentication_party_0"
+  "secure_authentication_party_0.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/secure_authentication_party_0.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/secure_authentication_party_1.dir/secure_authentication_party_1.cpp.o"
+  "CMakeFiles/secure_authentication_party_1.dir/secure_authentication_party_1.cpp.o.d"
+  "secure_authentication_party_1"
+  "secure_authentication_party_1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/secure_authentication_party_1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/com_party_0.dir/com_party_0.cpp.o"
+  "CMakeFiles/com_party_0.dir/com_party_0.cpp.o.d"
+  "com_party_0"
+  "com_party_0.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/com_party_0.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
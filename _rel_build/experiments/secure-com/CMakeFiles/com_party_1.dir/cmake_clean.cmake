@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/com_party_1.dir/com_party_1.cpp.o"
+  "CMakeFiles/com_party_1.dir/com_party_1.cpp.o.d"
+  "com_party_1"
+  "com_party_1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/com_party_1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
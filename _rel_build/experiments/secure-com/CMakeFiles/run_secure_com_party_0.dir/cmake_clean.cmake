@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/run_secure_com_party_0"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/run_secure_com_party_0.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/networking/fss-client.cpp" "experiments/secure-com/CMakeFiles/secure_com_fss_lib.dir/__/__/src/networking/fss-client.cpp.o" "gcc" "experiments/secure-com/CMakeFiles/secure_com_fss_lib.dir/__/__/src/networking/fss-client.cpp.o.d"
+  "/root/repo/src/networking/fss-common.cpp" "experiments/secure-com/CMakeFiles/secure_com_fss_lib.dir/__/__/src/networking/fss-common.cpp.o" "gcc" "experiments/secure-com/CMakeFiles/secure_com_fss_lib.dir/__/__/src/networking/fss-common.cpp.o.d"
+  "/root/repo/src/networking/fss-server.cpp" "experiments/secure-com/CMakeFiles/secure_com_fss_lib.dir/__/__/src/networking/fss-server.cpp.o" "gcc" "experiments/secure-com/CMakeFiles/secure_com_fss_lib.dir/__/__/src/networking/fss-server.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/src/networking/CMakeFiles/bioauth-networking.dir/DependInfo.cmake"
+  "/root/repo/_rel_build/CMakeFiles/bioauth-timer.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_secure_com_complete"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/test_secure_com_complete.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bioauth-networking.dir/Party.cpp.o"
+  "CMakeFiles/bioauth-networking.dir/Party.cpp.o.d"
+  "libbioauth-networking.a"
+  "libbioauth-networking.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bioauth-networking.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,120 @@
+// Overhead of the batched MAC check on the online phase: both parties run in this process on loopback,
+// on a circuit of independent query x DB products, without the check, with one check at the end,
+// and with a check every few thousand opened values
+
+#include "share/Spdz2kShare.h"
+#include "protocols/Circuit.h"
+#include "fake-offline/FakeCircuit.h"
+#include "fake-offline/FakeParty.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <random>
+
+using namespace std;
+using namespace bioauth;
+
+namespace {
+
+using ShrType = Spdz2kShare64;
+using ClearType = ShrType::ClearType;
+
+const string kJobName = "MacCheckBenchmark";
+constexpr size_t kNumProducts = 8;
+constexpr size_t kPort = 6060;
+constexpr int kRepeats = 5;
+
+struct Mode {
+    string name;
+    bool enabled;
+    size_t interval;
+};
+
+// Returns the input gates, the queries of party 0 and the databases of party 1 in turn
+template <class CircuitType>
+auto buildCircuit(CircuitType& circuit, size_t dim, size_t dbsize) {
+    vector<decltype(circuit.input(0, 1, 1))> inputs;
+    for (size_t i = 0; i < kNumProducts; ++i) {
+        auto query = circuit.input(0, 1, dim);
+        auto db = circuit.input(1, dim, dbsize);
+        circuit.addEndpoint(circuit.output(circuit.multiply(query, db)));
+        inputs.push_back(query);
+        inputs.push_back(db);
+    }
+    return inputs;
+}
+
+// Returns party 0's time of the online phase in ms
+double runOnline(const Mode& mode, size_t port, size_t dim, size_t dbsize) {
+    double elapsed = 0;
+    auto run = [&](size_t id) {
+        PartyWithFakeOffline<ShrType> party(id, 2, port, kJobName);
+        party.mac_checker().set_enabled(mode.enabled);
+        party.mac_checker().set_interval(mode.interval);
+
+        Circuit<ShrType> circuit(party);
+        auto inputs = buildCircuit(circuit, dim, dbsize);
+        mt19937_64 rng(id); // getRand is not shared between the threads
+        for (size_t i = id; i < inputs.size(); i += 2) {
+            vector<ClearType> values(inputs[i]->dim_row() * inputs[i]->dim_col());
+            generate(values.begin(), values.end(), [&rng] { return static_cast<ClearType>(rng()); });
+            inputs[i]->setInput(values);
+        }
+        circuit.readOfflineFromFile();
+        circuit.runOnlineWithBenckmark();
+        if (id == 0)
+            elapsed = circuit.timer().elapsed();
+    };
+    thread party_1(run, 1);
+    run(0);
+    party_1.join();
+    return elapsed;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t dim = argc > 1 ? stoul(argv[1]) : 1024;
+    size_t dbsize = argc > 2 ? stoul(argv[2]) : 512;
+
+    {
+        FakeParty<ShrType, 2> fake_party(kJobName);
+        FakeCircuit<ShrType, 2> fake_circuit(fake_party);
+        buildCircuit(fake_circuit, dim, dbsize);
+        fake_circuit.runOffline();
+    }
+
+    const vector<Mode> modes = {
+        {"no check", false, 0},
+        {"check at the end", true, 0},
+        {"check every 4096 values", true, 4096},
+    };
+
+    cout << kNumProducts << " products of 1x" << dim << " by " << dim << 'x' << dbsize
+         << ", best of " << kRepeats << " runs\n";
+    cout << left << setw(28) << "mode" << right << setw(14) << "time (ms)" << setw(12) << "overhead" << '\n';
+
+    size_t port = kPort;
+    runOnline(modes.front(), port, dim, dbsize); // warm up, e.g., the page cache of the preprocessing files
+    port += 10;
+
+    // The modes take turns, so that drifts of the machine affect all of them alike
+    vector<double> best(modes.size(), 1e300);
+    for (int r = 0; r < kRepeats; ++r) {
+        for (size_t m = 0; m < modes.size(); ++m) {
+            best[m] = min(best[m], runOnline(modes[m], port, dim, dbsize));
+            port += 10;
+        }
+    }
+
+    for (size_t m = 0; m < modes.size(); ++m) {
+        cout << left << setw(28) << modes[m].name << right << fixed << setprecision(2) << setw(14) << best[m]
+             << setw(11) << (best[m] / best[0] - 1) * 100 << "%\n";
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef BIOAUTH_OT_OFFLINE_CONFIG_H
+#define BIOAUTH_OT_OFFLINE_CONFIG_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+#include "../dot-product-db/dot_product_db_config.h"
+#include "share/Spdz2kShare.h"
+#include "ot-offline/OTCircuit.h"
+
+namespace bioauth::experiments::ot_offline {
+
+using namespace bioauth::experiments::dot_product;
+
+constexpr std::size_t kPort = 5060;
+
+/// Generates the preprocessing data of the dot-product-db circuit with the OT-based offline phase,
+/// the online parties of dot-product-db read them as they read the fake offline data.
+/// The optional argument selects how the triples are multiplied, "ot" (default) or "paillier".
+inline
+int runOffline(std::size_t party_id, int argc, char** argv) {
+    using ShrType = Spdz2kShare64;
+
+    std::string backend_name = argc > 1 ? argv[1] : "ot";
+    if (backend_name != "ot" && backend_name != "paillier") {
+        std::cerr << "Usage: " << argv[0] << " [ot|paillier]" << std::endl;
+        return 1;
+    }
+    auto backend = backend_name == "paillier" ? TripleBackend::kPaillier : TripleBackend::kOT;
+
+    std::cout << "\n=== OT-based Offline Phase (" << backend_name << ") - Party " << party_id << " ===" << std::endl;
+    std::cout << "Vector length: " << dim << ", Database size: " << dbsize << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    OTParty<ShrType> party(party_id, 2, kPort, kJobName, backend);
+    OTCircuit<ShrType> circuit(party);
+
+    auto a = circuit.input(0, 1, dim);
+    auto b = circuit.input(1, dim, dbsize);
+    auto c = circuit.multiply(a, b);
+    auto d = circuit.output(c);
+    circuit.addEndpoint(d);
+
+    circuit.runOffline();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double comm = party.bytes_sent() / 1024.0;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Time: " << seconds * 1000 << " ms (multiplications: " << party.multiply_seconds() * 1000 << " ms)"
+              << std::endl;
+    std::cout << "Communication: " << comm << " KB (" << comm / 1024.0 << " MB)" << std::endl;
+    std::cout << "Triples: " << party.num_triples() << " ("
+              << party.num_triples() / party.multiply_seconds() << " triples/s)" << std::endl;
+    return 0;
+}
+
+} // namespace bioauth::experiments::ot_offline
+
+#endif //BIOAUTH_OT_OFFLINE_CONFIG_H
@@ -0,0 +1,5 @@
+#include "ot_offline_config.h"
+
+int main(int argc, char** argv) {
+    return bioauth::experiments::ot_offline::runOffline(1, argc, argv);
+}
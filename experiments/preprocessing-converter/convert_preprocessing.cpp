@@ -0,0 +1,105 @@
+// Converts the text preprocessing files of older runs ("<job>-party-<i>.txt") to the binary format
+// read by PartyWithFakeOffline ("<job>-party-<i>.bin"), see utils/preprocessing_file.h
+//
+// Usage: convert_preprocessing [--bits 32|64] <input.txt> [output.bin]
+//
+// The text format does not record which values are clear values and which are shares,
+// so everything after the key is stored with the width of the shares (SemiShrType).
+// The reader narrows them back when a gate reads clear values.
+
+#include "share/Spdz2kShare.h"
+#include "share/IsSpdz2kShare.h"
+#include "utils/preprocessing_file.h"
+#include "utils/uint128_io.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace bioauth;
+
+namespace {
+
+// Values per section, so that large files are converted in bounded memory
+constexpr size_t kChunkSize = size_t{1} << 20;
+
+template <IsSpdz2kShare ShrType>
+void convert(const filesystem::path& input_path, const filesystem::path& output_path) {
+    using KeyShrType = typename ShrType::KeyShrType;
+    using SemiShrType = typename ShrType::SemiShrType;
+
+    ifstream input(input_path);
+    if (!input) {
+        throw runtime_error("Cannot open " + input_path.string());
+    }
+
+    KeyShrType key_shr;
+    if (!(input >> key_shr)) {
+        throw runtime_error(input_path.string() + " does not start with a key share");
+    }
+
+    PreprocessingWriter output(output_path);
+    output.write(SectionKind::kKey, span<const KeyShrType>(&key_shr, 1));
+
+    vector<SemiShrType> chunk;
+    chunk.reserve(kChunkSize);
+    size_t num_values = 0;
+    SemiShrType value;
+    while (input >> value) {
+        chunk.push_back(value);
+        if (chunk.size() == kChunkSize) {
+            output.write(SectionKind::kShares, chunk);
+            num_values += chunk.size();
+            chunk.clear();
+        }
+    }
+    if (!input.eof()) {
+        throw runtime_error("Malformed value after " + to_string(num_values + chunk.size()) +
+                            " values in " + input_path.string());
+    }
+    if (!chunk.empty()) {
+        output.write(SectionKind::kShares, chunk);
+        num_values += chunk.size();
+    }
+    output.close();
+
+    if (!PreprocessingReader(output_path).verify()) {
+        throw runtime_error("Checksum mismatch after writing " + output_path.string());
+    }
+    cout << "Converted " << num_values << " values from " << input_path << " to " << output_path << endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    vector<string> args(argv + 1, argv + argc);
+
+    int bits = 64;
+    if (args.size() >= 2 && args[0] == "--bits") {
+        bits = stoi(args[1]);
+        args.erase(args.begin(), args.begin() + 2);
+    }
+    if (args.empty() || args.size() > 2 || (bits != 32 && bits != 64)) {
+        cerr << "Usage: " << argv[0] << " [--bits 32|64] <input.txt> [output.bin]" << endl;
+        return 1;
+    }
+
+    filesystem::path input_path = args[0];
+    filesystem::path output_path = args.size() == 2 ? filesystem::path(args[1])
+                                                    : filesystem::path(input_path).replace_extension(".bin");
+
+    try {
+        if (bits == 32) {
+            convert<Spdz2kShare32>(input_path, output_path);
+        } else {
+            convert<Spdz2kShare64>(input_path, output_path);
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+// Microbenchmark of the Z_{2^k} matrix multiplication kernels against Eigen,
+// and of the fused MultiplyGate products against separate GEMMs
+
+#include "share/Spdz2kShare.h"
+#include "utils/linear_algebra.h"
+#include "utils/rand.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using namespace std;
+using namespace bioauth;
+
+namespace {
+
+constexpr int kRepeats = 5;
+
+// Shapes of the authentication query: (dim_row, dim_mid, dim_col)
+const vector<tuple<size_t, size_t, size_t>> kShapes = {
+    {1, 128, 1},
+    {1, 1024, 1},
+    {1, 128, 512},
+    {1, 512, 512},
+    {1, 1024, 512},
+    {1, 1024, 4096},
+    {1, 4096, 4096},
+    {64, 256, 256},
+    {256, 256, 256},
+};
+
+template <typename Func>
+double bestOfMicroseconds(const Func& f) {
+    double best = 1e300;
+    for (int r = 0; r < kRepeats; ++r) {
+        auto start = chrono::steady_clock::now();
+        f();
+        auto stop = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double, micro>(stop - start).count());
+    }
+    return best;
+}
+
+template <typename T>
+void benchmark(const string& type_name) {
+    cout << "\n=== " << type_name << " ===\n";
+    cout << setw(6) << "rows" << setw(8) << "dim" << setw(8) << "dbsize"
+         << setw(14) << "Eigen (us)" << setw(14) << "ringGemm (us)" << setw(10) << "speedup" << '\n';
+
+    for (auto [dim_row, dim_mid, dim_col] : kShapes) {
+        vector<T> lhs(dim_row * dim_mid), rhs(dim_mid * dim_col);
+        generate(lhs.begin(), lhs.end(), getRand<T>);
+        generate(rhs.begin(), rhs.end(), getRand<T>);
+        vector<T> out_eigen(dim_row * dim_col), out_ring(dim_row * dim_col);
+
+        auto time_eigen = bestOfMicroseconds([&] {
+            matrixMultiplyEigen(lhs.data(), rhs.data(), out_eigen.data(), dim_row, dim_mid, dim_col);
+        });
+        auto time_ring = bestOfMicroseconds([&] {
+            ringGemm(lhs.data(), rhs.data(), out_ring.data(), dim_row, dim_mid, dim_col);
+        });
+
+        if (out_eigen != out_ring) {
+            cerr << "Mismatch between Eigen and ringGemm for shape "
+                 << dim_row << 'x' << dim_mid << 'x' << dim_col << '\n';
+            exit(1);
+        }
+
+        cout << setw(6) << dim_row << setw(8) << dim_mid << setw(8) << dim_col
+             << fixed << setprecision(1)
+             << setw(14) << time_eigen << setw(14) << time_ring
+             << setprecision(2) << setw(9) << time_eigen / time_ring << "x\n";
+    }
+}
+
+// The products of MultiplyGate: four separate GEMMs with temporaries, against the fused pass
+template <typename T>
+void benchmarkBeaver(const string& type_name) {
+    cout << "\n=== MultiplyGate products, " << type_name << " ===\n";
+    cout << setw(6) << "rows" << setw(8) << "dim" << setw(8) << "dbsize"
+         << setw(14) << "separate (us)" << setw(14) << "fused (us)" << setw(10) << "speedup" << '\n';
+
+    for (auto [dim_row, dim_mid, dim_col] : kShapes) {
+        auto size_lhs = dim_row * dim_mid, size_rhs = dim_mid * dim_col, size_out = dim_row * dim_col;
+        vector<T> x(size_lhs), a(size_lhs), a_mac(size_lhs);
+        vector<T> y(size_rhs), b(size_rhs), b_mac(size_rhs);
+        vector<T> z_init(size_out), z_mac_init(size_out);
+        for (auto* vec : {&x, &a, &a_mac, &y, &b, &b_mac, &z_init, &z_mac_init}) {
+            generate(vec->begin(), vec->end(), getRand<T>);
+        }
+
+        vector<T> xy_sep, z_sep, z_mac_sep;
+        auto time_separate = bestOfMicroseconds([&] {
+            xy_sep = matrixMultiply(x, y, dim_row, dim_mid, dim_col);
+            z_sep = z_init;
+            matrixSubtractAssign(z_sep, matrixMultiply(a, y, dim_row, dim_mid, dim_col));
+            matrixSubtractAssign(z_sep, matrixMultiply(x, b, dim_row, dim_mid, dim_col));
+            z_mac_sep = z_mac_init;
+            matrixSubtractAssign(z_mac_sep, matrixMultiply(a_mac, y, dim_row, dim_mid, dim_col));
+            matrixSubtractAssign(z_mac_sep, matrixMultiply(x, b_mac, dim_row, dim_mid, dim_col));
+        });
+
+        vector<T> xy_fused, z_fused, z_mac_fused;
+        auto time_fused = bestOfMicroseconds([&] {
+            xy_fused.assign(size_out, T(0));
+            z_fused = z_init;
+            z_mac_fused = z_mac_init;
+            fusedBeaverGemm(x.data(), y.data(), a.data(), a_mac.data(), b.data(), b_mac.data(),
+                            xy_fused.data(), z_fused.data(), z_mac_fused.data(), dim_row, dim_mid, dim_col);
+        });
+
+        if (xy_sep != xy_fused || z_sep != z_fused || z_mac_sep != z_mac_fused) {
+            cerr << "Mismatch between separate and fused products for shape "
+                 << dim_row << 'x' << dim_mid << 'x' << dim_col << '\n';
+            exit(1);
+        }
+
+        cout << setw(6) << dim_row << setw(8) << dim_mid << setw(8) << dim_col
+             << fixed << setprecision(1)
+             << setw(14) << time_separate << setw(14) << time_fused
+             << setprecision(2) << setw(9) << time_separate / time_fused << "x\n";
+    }
+}
+
+} // namespace
+
+int main() {
+    benchmark<Spdz2kShare64::ClearType>("Z_{2^64} (ClearType of Spdz2kShare64)");
+    benchmark<Spdz2kShare64::SemiShrType>("Z_{2^128} (SemiShrType of Spdz2kShare64)");
+    benchmarkBeaver<Spdz2kShare64::SemiShrType>("Z_{2^128} (SemiShrType of Spdz2kShare64)");
+    return 0;
+}
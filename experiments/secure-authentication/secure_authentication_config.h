@@ -9,12 +9,34 @@
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <tuple>
+#include <cstdint>
+
+#include "protocols/SecureArgmax.h"
 
 namespace bioauth::experiments::secure_authentication {
 
 const std::string kJobName = "SecureAuthentication";
 constexpr std::size_t dim = 1024;      // vector length
 constexpr std::size_t dbsize = 512;    // database size
+constexpr uint64_t kFeatureBound = 256; // features are in [0, kFeatureBound), so the scores fit in 63 bits
+
+/// The similarity scores of the query (party 0) with the database (party 1), their maximum and its index.
+/// Used by both the online parties and the fake offline phase, so that they build the same gates.
+/// Returns the query and database input gates and the output gates of the maximum and the index.
+template <class CircuitType>
+auto buildAuthenticationCircuit(CircuitType& circuit) {
+    auto query_vector = circuit.input(0, 1, dim);
+    auto database_vectors = circuit.input(1, dim, dbsize);
+    auto scores = circuit.multiply(query_vector, database_vectors);
+
+    SecureArgmax argmax(circuit, scores);
+    auto max_score = circuit.output(argmax.max());
+    auto max_index = circuit.output(argmax.index());
+    circuit.addEndpoint(max_score);
+    circuit.addEndpoint(max_index);
+    return std::make_tuple(query_vector, database_vectors, max_score, max_index);
+}
 
 }
 
@@ -82,13 +104,4 @@ inline void handleTestCleanup() {
     std::this_thread::sleep_for(std::chrono::seconds(1));
 }
 
-namespace FSS_Config {
-    constexpr size_t DEFAULT_ROUNDS = 256;
-    constexpr uint32_t FSS_NUM_BITS = 10;
-    constexpr uint32_t FSS_NUM_PARTIES = 2;
-    constexpr uint64_t TEST_VALUE_A = 3;
-    constexpr uint64_t TEST_VALUE_B0 = 1;
-    constexpr uint64_t TEST_VALUE_B1 = -1;
-}
-
 #endif // BIOAUTH_VECTOR_SELECTION_CONFIG_H
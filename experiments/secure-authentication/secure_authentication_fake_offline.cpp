@@ -0,0 +1,31 @@
+// by sakara
+
+#include "secure_authentication_config.h"
+
+#include "fake-offline/FakeCircuit.h"
+#include "fake-offline/FakeParty.h"
+#include "share/Spdz2kShare.h"
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+using namespace bioauth;
+using namespace bioauth::experiments::secure_authentication;
+
+
+int main() {
+    using ShrType = bioauth::Spdz2kShare64;
+
+    FakeParty<ShrType, 2> party(kJobName);
+    FakeCircuit<ShrType, 2> circuit(party);
+    auto start = std::chrono::high_resolution_clock::now();
+    buildAuthenticationCircuit(circuit);
+
+    circuit.runOffline();
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    std::cout << "Offline phase took " << duration << " ms." << std::endl;
+    std::cout << "Offline comm cost " << party.getTotalOfflineBytesWritten() << " bytes." << std::endl;
+
+    return 0;
+}
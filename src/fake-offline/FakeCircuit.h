@@ -14,6 +14,8 @@
 #include "fake-offline/FakeAddGate.h"
 #include "fake-offline/FakeSubtractGate.h"
 #include "fake-offline/FakeAddConstantGate.h"
+#include "fake-offline/FakeConstantGate.h"
+#include "fake-offline/FakeGatherGate.h"
 #include "fake-offline/FakeMultiplyGate.h"
 #include "fake-offline/FakeOutputGate.h"
 #include "fake-offline/FakeMultiplyTruncGate.h"
@@ -37,6 +39,7 @@ class FakeCircuit {
 public:
     using SemiShrType = typename ShrType::SemiShrType;
     using ClearType = typename ShrType::ClearType;
+    using GateType = FakeGate<ShrType, N>;
 
     explicit FakeCircuit(FakeParty<ShrType, N>& p_fake_party) : fake_party_(p_fake_party) {}
 
@@ -59,6 +62,13 @@ public:
     addConstant(const std::shared_ptr<FakeGate<ShrType, N>>& input_x,
                 ClearType constant);
 
+    /// Public values, they take no preprocessing, so only the dimensions matter here
+    std::shared_ptr<FakeConstantGate<ShrType, N>>
+    constant(std::size_t dim_row, std::size_t dim_col, const std::vector<ClearType>& values);
+
+    std::shared_ptr<FakeGatherGate<ShrType, N>>
+    gather(const std::shared_ptr<FakeGate<ShrType, N>>& input_x, const std::vector<std::size_t>& indices);
+
     std::shared_ptr<FakeMultiplyGate<ShrType, N>>
     multiply(const std::shared_ptr<FakeGate<ShrType, N>>& input_x,
              const std::shared_ptr<FakeGate<ShrType, N>>& input_y);
@@ -173,6 +183,24 @@ addConstant(const std::shared_ptr<FakeGate<ShrType, N>>& input_x,
     return gate;
 }
 
+template <IsSpdz2kShare ShrType, std::size_t N>
+std::shared_ptr<FakeConstantGate<ShrType, N>> FakeCircuit<ShrType, N>::
+constant(std::size_t dim_row, std::size_t dim_col, const std::vector<ClearType>&) {
+    auto gate = std::make_shared<FakeConstantGate<ShrType, N>>(fake_party_, dim_row, dim_col);
+    gates_.push_back(gate);
+    gate_type_count_[typeid(*gate).name()]++;
+    return gate;
+}
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+std::shared_ptr<FakeGatherGate<ShrType, N>> FakeCircuit<ShrType, N>::
+gather(const std::shared_ptr<FakeGate<ShrType, N>>& input_x, const std::vector<std::size_t>& indices) {
+    auto gate = std::make_shared<FakeGatherGate<ShrType, N>>(input_x, indices);
+    gates_.push_back(gate);
+    gate_type_count_[typeid(*gate).name()]++;
+    return gate;
+}
+
 template <IsSpdz2kShare ShrType, std::size_t N>
 std::shared_ptr<FakeMultiplyGate<ShrType, N>> FakeCircuit<ShrType, N>::
 multiply(const std::shared_ptr<FakeGate<ShrType, N>>& input_x,
@@ -0,0 +1,41 @@
+#ifndef BIOAUTH_FAKECONSTANTGATE_H
+#define BIOAUTH_FAKECONSTANTGATE_H
+
+#include <memory>
+#include <vector>
+
+#include "share/IsSpdz2kShare.h"
+#include "fake-offline/FakeGate.h"
+
+
+namespace bioauth {
+
+/// A matrix of public values, lambda is 0 and nothing is written (see protocols/ConstantGate.h)
+template <IsSpdz2kShare ShrType, std::size_t N>
+class FakeConstantGate : public FakeGate<ShrType, N> {
+public:
+    FakeConstantGate(FakeParty<ShrType, N>& p_fake_party, std::size_t p_dim_row, std::size_t p_dim_col);
+
+private:
+    void doRunOffline() override;
+};
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+FakeConstantGate<ShrType, N>::
+FakeConstantGate(FakeParty<ShrType, N>& p_fake_party, std::size_t p_dim_row, std::size_t p_dim_col)
+    : FakeGate<ShrType, N>(p_fake_party, p_dim_row, p_dim_col) {}
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+void FakeConstantGate<ShrType, N>::doRunOffline() {
+    auto size = this->dim_row() * this->dim_col();
+
+    this->lambda_clear().assign(size, 0);
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        this->lambda_shr()[party_idx].assign(size, 0);
+        this->lambda_shr_mac()[party_idx].assign(size, 0);
+    }
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_FAKECONSTANTGATE_H
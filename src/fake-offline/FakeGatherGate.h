@@ -0,0 +1,51 @@
+#ifndef BIOAUTH_FAKEGATHERGATE_H
+#define BIOAUTH_FAKEGATHERGATE_H
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "utils/linear_algebra.h"
+#include "share/IsSpdz2kShare.h"
+#include "fake-offline/FakeGate.h"
+
+
+namespace bioauth {
+
+/// Entry i of the output is entry indices[i] of the input, nothing is written (see protocols/GatherGate.h)
+template <IsSpdz2kShare ShrType, std::size_t N>
+class FakeGatherGate : public FakeGate<ShrType, N> {
+public:
+    FakeGatherGate(const std::shared_ptr<FakeGate<ShrType, N>>& p_input_x, const std::vector<std::size_t>& indices);
+
+private:
+    void doRunOffline() override;
+
+    std::vector<std::size_t> indices_;
+};
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+FakeGatherGate<ShrType, N>::
+FakeGatherGate(const std::shared_ptr<FakeGate<ShrType, N>>& p_input_x, const std::vector<std::size_t>& indices)
+    : FakeGate<ShrType, N>(p_input_x, nullptr), indices_(indices) {
+    auto size = p_input_x->dim_row() * p_input_x->dim_col();
+    if (std::ranges::any_of(indices, [size](std::size_t i) { return i >= size; })) {
+        throw std::out_of_range("The indices of the gather gate should be less than the size of its input");
+    }
+    this->set_dim_row(1);
+    this->set_dim_col(indices.size());
+}
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+void FakeGatherGate<ShrType, N>::doRunOffline() {
+    this->lambda_clear() = gatherVector(this->input_x()->lambda_clear(), indices_);
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        this->lambda_shr()[party_idx] = gatherVector(this->input_x()->lambda_shr()[party_idx], indices_);
+        this->lambda_shr_mac()[party_idx] = gatherVector(this->input_x()->lambda_shr_mac()[party_idx], indices_);
+    }
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_FAKEGATHERGATE_H
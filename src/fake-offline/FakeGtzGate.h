@@ -4,10 +4,16 @@
 
 #include <memory>
 #include <array>
+#include <vector>
 #include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <cstdint>
 
 #include "utils/rand.h"
+#include "utils/bit_slice.h"
 #include "share/IsSpdz2kShare.h"
+#include "protocols/AuthBits.h"
 #include "fake-offline/FakeGate.h"
 
 
@@ -22,7 +28,20 @@ public:
     explicit FakeGtzGate(const std::shared_ptr<FakeGate<ShrType, N>>& p_input_x);
 
 private:
+    using AllPartiesWords = std::array<std::vector<uint64_t>, N>;
+
+    static constexpr std::size_t kNumBits = sizeof(ClearType) * 8;
+    // The carry tree of GtzGate reduces kNumBits - 1 planes to one, each pair of planes it combines takes two triples
+    static constexpr std::size_t kNumPairs = kNumBits - 2;
+
     static std::array<ClearType, N> generateBooleanShares(ClearType x);
+
+    // Writes the MACs of the parties' bit-sliced shares, then the keys
+    void writeMacsAndKeys(const AllPartiesWords& shares, const std::array<BitMacKeyMasks, N>& deltas);
+
+    // Writes random shares of the bit-sliced values, then their MACs and keys
+    void writeAuthBits(const std::vector<uint64_t>& values, const std::array<BitMacKeyMasks, N>& deltas);
+
     void doRunOffline() override;
 };
 
@@ -30,6 +49,9 @@ template <IsSpdz2kShare ShrType, std::size_t N>
 FakeGtzGate<ShrType, N>::
 FakeGtzGate(const std::shared_ptr<FakeGate<ShrType, N>>& p_input_x)
     : FakeGate<ShrType, N>(p_input_x, nullptr) {
+    if (N != 2) {
+        throw std::invalid_argument("The binary MACs of the comparison are for two parties only");
+    }
     this->set_dim_row(p_input_x->dim_row());
     this->set_dim_col(p_input_x->dim_col());
 }
@@ -46,6 +68,44 @@ FakeGtzGate<ShrType, N>::generateBooleanShares(ClearType x) {
     return ret;
 }
 
+template <IsSpdz2kShare ShrType, std::size_t N>
+void FakeGtzGate<ShrType, N>::
+writeMacsAndKeys(const AllPartiesWords& shares, const std::array<BitMacKeyMasks, N>& deltas) {
+    AllPartiesWords macs;
+    AllPartiesWords keys;
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        const auto other = 1 - party_idx;
+        const auto num_words = shares[party_idx].size();
+        auto& key = keys[other];
+        key.resize(num_words * kBitMacBits);
+        std::ranges::generate(key, getRand<uint64_t>);
+
+        // mac[r] = key[r] ^ (Delta_other[r] ? x : 0)
+        auto& mac = macs[party_idx];
+        mac.resize(num_words * kBitMacBits);
+        for (std::size_t w = 0; w < num_words; ++w) {
+            for (std::size_t r = 0; r < kBitMacBits; ++r) {
+                mac[w * kBitMacBits + r] = key[w * kBitMacBits + r] ^ (deltas[other][r] & shares[party_idx][w]);
+            }
+        }
+    }
+    this->fake_party().WriteBitsToAllParties(macs);
+    this->fake_party().WriteBitsToAllParties(keys);
+}
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+void FakeGtzGate<ShrType, N>::
+writeAuthBits(const std::vector<uint64_t>& values, const std::array<BitMacKeyMasks, N>& deltas) {
+    AllPartiesWords shares;
+    shares[0].resize(values.size());
+    std::ranges::generate(shares[0], getRand<uint64_t>);
+    shares[1].resize(values.size());
+    std::ranges::transform(values, shares[0], shares[1].begin(), std::bit_xor<>());
+
+    this->fake_party().WriteBitsToAllParties(shares);
+    writeMacsAndKeys(shares, deltas);
+}
+
 template <IsSpdz2kShare ShrType, std::size_t N>
 void FakeGtzGate<ShrType, N>::doRunOffline() {
     auto size = this->dim_row() * this->dim_col();
@@ -63,14 +123,48 @@ void FakeGtzGate<ShrType, N>::doRunOffline() {
     this->fake_party().WriteSharesToAllParites(this->lambda_shr());
     this->fake_party().WriteSharesToAllParites(this->lambda_shr_mac());
 
-    // Boolean shares of lambda_x
+    // Boolean shares of lambda_x, the lambda of the input, which the online phase compares Delta_x with
     // TODO: clean up the code, extract the boolean share generation to a function
+    const auto& lambda_x = this->input_x()->lambda_clear();
+    std::array<std::vector<ClearType>, N> lambda_x_bin_shr;
+    std::ranges::for_each(lambda_x_bin_shr, [size](auto& vec) { vec.resize(size); });
     for (std::size_t vec_idx = 0; vec_idx < size; ++vec_idx) {
-        auto shares_i = generateBooleanShares(this->lambda_clear()[vec_idx]);
+        auto shares_i = generateBooleanShares(lambda_x[vec_idx]);
         for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
-            this->fake_party().ithPartyFile(party_idx) << shares_i[party_idx] << '\n';
+            lambda_x_bin_shr[party_idx][vec_idx] = shares_i[party_idx];
         }
     }
+    this->fake_party().WriteClearSharesToAllParties(lambda_x_bin_shr);
+
+    // The binary MAC keys of this gate, and the MACs of the boolean shares of lambda_x
+    std::array<BitMacKeyMasks, N> deltas;
+    AllPartiesWords delta_words;
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        delta_words[party_idx] = {getRand<uint64_t>() & ((uint64_t{1} << kBitMacBits) - 1)};
+        deltas[party_idx] = bitMacKeyMasks(delta_words[party_idx].front());
+    }
+    this->fake_party().WriteBitsToAllParties(delta_words);
+
+    AllPartiesWords lambda_x_bits;
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        lambda_x_bits[party_idx] = bitSlice<ClearType>(lambda_x_bin_shr[party_idx], kNumBits);
+    }
+    writeMacsAndKeys(lambda_x_bits, deltas);
+
+    // Binary triples for the carry tree, bit-sliced pair plane after pair plane.
+    // The two triples of a pair share b: (a_p, b, a_p & b) and (a_g, b, a_g & b)
+    const auto num_words = kNumPairs * numBitSliceWords(size);
+    std::vector<uint64_t> a_p(num_words), a_g(num_words), b(num_words), c_p(num_words), c_g(num_words);
+    for (std::size_t w = 0; w < num_words; ++w) {
+        a_p[w] = getRand<uint64_t>();
+        a_g[w] = getRand<uint64_t>();
+        b[w] = getRand<uint64_t>();
+        c_p[w] = a_p[w] & b[w];
+        c_g[w] = a_g[w] & b[w];
+    }
+    for (const auto* values : {&a_p, &a_g, &b, &c_p, &c_g}) {
+        writeAuthBits(*values, deltas);
+    }
 }
 
 
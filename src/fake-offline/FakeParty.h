@@ -8,15 +8,17 @@
 #include <numeric>
 #include <algorithm>
 #include <cstddef>
-#include <sstream>
+#include <cstdint>
+#include <memory>
 #include "share/IsSpdz2kShare.h"
 #include "utils/rand.h"
-#include "utils/uint128_io.h"
+#include "utils/preprocessing_file.h"
+#include "utils/aes_ctr_prg.h"
 
 namespace bioauth {
 
 /// A fake party that generates all preprocessing data for all parties,
-/// the preprocessed data are stored in local files.
+/// the preprocessed data are stored in local binary files (see utils/preprocessing_file.h).
 /// Note that only one FakeParty object should be created for each job.
 ///
 /// @tparam ShrType The type of the shares, should be a Spdz2kShare<K, S> type
@@ -44,20 +46,25 @@ public:
 
     /// Constructs a FakeParty object
     /// @param job_name (optional) The name of the job, used to generate the output file names,
-    ///                 if not provided, the output file names will be "party-0.txt", "party-1.txt", ...
-    ///                 Otherwise, the output file names will be "<job_name>-party-0.txt", etc.
-    explicit FakeParty(const std::string& job_name = std::string());
+    ///                 if not provided, the output file names will be "party-0.bin", "party-1.bin", ...
+    ///                 Otherwise, the output file names will be "<job_name>-party-0.bin", etc.
+    /// @param seeded_shares (optional) If true, the random shares of the first N - 1 parties are taken from
+    ///                      per-party AES-CTR generators and only their seeds are stored,
+    ///                      so only the last party's shares take space in the files.
+    explicit FakeParty(const std::string& job_name = std::string(), bool seeded_shares = false);
 
     /// Returns the number of parties
     auto constexpr static NParties() noexcept { return N; }
 
+    [[nodiscard]] bool seeded_shares() const { return seeded_shares_; }
+
     std::size_t getTotalOfflineBytesWritten() const {
     return total_bytes_written_;
     std::size_t input_bytes_written_ = 0;
 }
 
-    /// Returns the i-th party's output ofstream
-    [[nodiscard]] auto& ithPartyFile(std::size_t i) { return output_files_.at(i); }
+    /// Returns the i-th party's preprocessing file writer
+    [[nodiscard]] auto& ithPartyFile(std::size_t i) { return *output_files_.at(i); }
 
         /// 获取第 i 个 party 的 MAC key（α_i）
     [[nodiscard]] KeyShrType mac_key(std::size_t i) const {
@@ -71,12 +78,21 @@ public:
     // void WriteSharesToAllParites(const std::array<std::vector<SemiShrType>, N>& shares,
     //                              const std::array<std::vector<SemiShrType>, N>& macs);
 
-    void WriteSharesToAllParites(const std::array<std::vector<SemiShrType>, N>& shares);
+    /// Write the i-th party's shares to its file.
+    /// With seeded shares, the first N - 1 parties' shares are replaced in place by the outputs of their generators
+    /// and the last party's shares are corrected accordingly, so the shared values stay the same.
+    void WriteSharesToAllParites(std::array<std::vector<SemiShrType>, N>& shares);
 
     void WriteClearToIthParty(const std::vector<ClearType>& values, std::size_t party_id);
 
     void WriteClearToAllParties(const std::vector<ClearType>& values);
 
+    /// Write the i-th vector to the i-th party, for values each party knows in clear (e.g., boolean shares)
+    void WriteClearSharesToAllParties(const std::array<std::vector<ClearType>, N>& values);
+
+    /// Write the i-th vector of bit-sliced binary shares, MACs or keys to the i-th party (see protocols/AuthBits.h)
+    void WriteBitsToAllParties(const std::array<std::vector<uint64_t>, N>& words);
+
     /// Simulate sending data to another party (just count the bytes)
     void SimulateSendToOther(const std::vector<SemiShrType>& data);
       
@@ -85,21 +101,23 @@ private:
     inline static const std::filesystem::path kFakeOfflineDir{FAKE_OFFLINE_DIR}; // The macro is in CMakeLists.txt
     GlobalKeyType global_key_;
     std::array<KeyShrType, N> key_shares_;
-    std::array<std::ofstream, N> output_files_;
+    std::array<std::unique_ptr<PreprocessingWriter>, N> output_files_;
+    bool seeded_shares_;
+    std::array<std::unique_ptr<AesCtrPrg>, N - 1> prgs_; // only used with seeded shares
     std::size_t total_bytes_written_ = 0;
     //typename ShrType::ClearType mac_key_;
 };
 
 template <IsSpdz2kShare ShrType, std::size_t N>
-FakeParty<ShrType, N>::FakeParty(const std::string& job_name) {
+FakeParty<ShrType, N>::FakeParty(const std::string& job_name, bool seeded_shares) : seeded_shares_(seeded_shares) {
     // Open the output files for each party
     if (!exists(kFakeOfflineDir)) {
         create_directory(kFakeOfflineDir);
     }
     const std::string file_name_suffix = job_name + (job_name.empty() ? "party-" : "-party-");
     for (std::size_t i = 0; i < N; ++i) {
-        std::string current_file_name = file_name_suffix + std::to_string(i) + ".txt";
-        output_files_[i].open(kFakeOfflineDir / current_file_name);
+        std::string current_file_name = file_name_suffix + std::to_string(i) + ".bin";
+        output_files_[i] = std::make_unique<PreprocessingWriter>(kFakeOfflineDir / current_file_name);
     }
 
     // Generate the MAC key
@@ -111,7 +129,16 @@ FakeParty<ShrType, N>::FakeParty(const std::string& job_name) {
 
     // Write the MAC key to the output files for each party
     for (std::size_t i = 0; i < N; ++i) {
-        output_files_[i] << key_shares_[i] << '\n';
+        ithPartyFile(i).write(SectionKind::kKey, std::span<const KeyShrType>(&key_shares_[i], 1));
+    }
+
+    // The seeds of the generators, the reader expands the seeded shares with them
+    if (seeded_shares_) {
+        for (std::size_t i = 0; i < N - 1; ++i) {
+            auto seed = AesCtrPrg::randomSeed();
+            ithPartyFile(i).write(SectionKind::kSeed, std::span<const uint8_t>(seed));
+            prgs_[i] = std::make_unique<AesCtrPrg>(seed);
+        }
     }
     //mac_key_ = getRand<typename ShrType::ClearType>();
 }
@@ -180,47 +207,57 @@ GenerateAllPartiesShares(const std::vector<ClearType>& value) const {
 // }
 
 template <IsSpdz2kShare ShrType, std::size_t N>
-void FakeParty<ShrType, N>::WriteSharesToAllParites(const std::array<std::vector<SemiShrType>, N>& shares) {
-    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
-        auto& output_file = ithPartyFile(party_idx);
-        for (auto& share : shares[party_idx]) {
-            std::ostringstream oss;
-            oss << share << '\n';
-            auto str = oss.str();
-            total_bytes_written_ += str.size();  // 累加字节数
-            output_file << str;
+void FakeParty<ShrType, N>::WriteSharesToAllParites(std::array<std::vector<SemiShrType>, N>& shares) {
+    if (seeded_shares_) {
+        auto& last_shares = shares.back();
+        for (std::size_t party_idx = 0; party_idx < N - 1; ++party_idx) {
+            auto size = shares[party_idx].size();
+            auto seeded = prgs_[party_idx]->template next<SemiShrType>(size);
+            for (std::size_t vec_idx = 0; vec_idx < size; ++vec_idx) {
+                last_shares[vec_idx] += shares[party_idx][vec_idx] - seeded[vec_idx];
+            }
+            shares[party_idx] = std::move(seeded);
+            ithPartyFile(party_idx).template writeSeeded<SemiShrType>(size);
         }
-        //std::ranges::for_each(shares[party_idx], [&output_file](auto share) { output_file << share << '\n'; });
+        ithPartyFile(N - 1).write(SectionKind::kShares, last_shares);
+        total_bytes_written_ += last_shares.size() * sizeof(SemiShrType);
+        return;
+    }
+
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        ithPartyFile(party_idx).write(SectionKind::kShares, shares[party_idx]);
+        total_bytes_written_ += shares[party_idx].size() * sizeof(SemiShrType);
     }
 }
 
 template <IsSpdz2kShare ShrType, std::size_t N>
 void FakeParty<ShrType, N>::WriteClearToIthParty(const std::vector<ClearType>& values, std::size_t party_id) {
-    auto& output_file = ithPartyFile(party_id);
-    //std::ranges::for_each(values, [&output_file](auto value) { output_file << value << '\n'; });
-    for (const auto& val : values) {
-        std::ostringstream oss;
-        oss << val << '\n';
-        auto str = oss.str();
-        total_bytes_written_ += str.size();  // 累加通信代价
-        output_file << str;
-    }
+    ithPartyFile(party_id).write(SectionKind::kClear, values);
+    total_bytes_written_ += values.size() * sizeof(ClearType);
 }
 
 template <IsSpdz2kShare ShrType, std::size_t N>
 void FakeParty<ShrType, N>::WriteClearToAllParties(const std::vector<ClearType>& values) {
     for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
-        //WriteClearToIthParty(values, party_idx);
-        auto& output_file = ithPartyFile(party_idx);
-        for (const auto& val : values) {
-            std::ostringstream oss;
-            oss << val << '\n';
-            auto str = oss.str();
-            total_bytes_written_ += str.size();  // 累加通信代价
-            output_file << str;
-        }
+        WriteClearToIthParty(values, party_idx);
     }
 }
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+void FakeParty<ShrType, N>::WriteClearSharesToAllParties(const std::array<std::vector<ClearType>, N>& values) {
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        WriteClearToIthParty(values[party_idx], party_idx);
+    }
+}
+
+template <IsSpdz2kShare ShrType, std::size_t N>
+void FakeParty<ShrType, N>::WriteBitsToAllParties(const std::array<std::vector<uint64_t>, N>& words) {
+    for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
+        ithPartyFile(party_idx).write(SectionKind::kClear, words[party_idx]);
+        total_bytes_written_ += words[party_idx].size() * sizeof(uint64_t);
+    }
+}
+
 template <IsSpdz2kShare ShrType, std::size_t N>
 void FakeParty<ShrType, N>::SimulateSendToOther(const std::vector<SemiShrType>& data) {
     // 只累加通信字节数，不写入任何文件
@@ -43,6 +43,8 @@ template <IsSpdz2kShare ShrType, std::size_t N>
 void FakeSubtractGate<ShrType, N>::doRunOffline() {
     auto size = this->dim_row() * this->dim_col();
 
+    this->lambda_clear() = matrixSubtract(this->input_x()->lambda_clear(), this->input_y()->lambda_clear());
+
     // $[\lambda_z] = [\lambda_x] - [\lambda_y]$
     for (std::size_t party_idx = 0; party_idx < N; ++party_idx) {
         this->lambda_shr()[party_idx] = matrixSubtract(this->input_x()->lambda_shr()[party_idx],
@@ -0,0 +1,162 @@
+#ifndef BIOAUTH_BASEOT_H
+#define BIOAUTH_BASEOT_H
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+
+#include "networking/Party.h"
+
+namespace bioauth {
+
+/// A 128-bit string, the unit of the oblivious transfers
+using OTBlock = __uint128_t;
+
+/// Random 1-out-of-2 oblivious transfers between the two parties,
+/// "The Simplest Protocol for Oblivious Transfer" (Chou and Orlandi, https://ia.cr/2015/267) over NIST P-256.
+/// They are only used to set up the OT extension, so they are neither batched nor optimized.
+class BaseOT {
+public:
+    /// The sender gets both messages of each OT
+    static std::vector<std::array<OTBlock, 2>> send(Party& party, std::size_t num_ots);
+
+    /// The receiver gets the message of its choice of each OT
+    static std::vector<OTBlock> receive(Party& party, const std::vector<bool>& choices);
+
+private:
+    struct GroupDeleter { void operator()(EC_GROUP* p) const { EC_GROUP_free(p); } };
+    struct PointDeleter { void operator()(EC_POINT* p) const { EC_POINT_free(p); } };
+    struct BigNumDeleter { void operator()(BIGNUM* p) const { BN_free(p); } };
+    struct ContextDeleter { void operator()(BN_CTX* p) const { BN_CTX_free(p); } };
+
+    using Group = std::unique_ptr<EC_GROUP, GroupDeleter>;
+    using Point = std::unique_ptr<EC_POINT, PointDeleter>;
+    using BigNum = std::unique_ptr<BIGNUM, BigNumDeleter>;
+    using Context = std::unique_ptr<BN_CTX, ContextDeleter>;
+
+    static constexpr std::size_t kPointSize = 33; // compressed encoding
+
+    static void check(int ok) {
+        if (ok != 1) {
+            throw std::runtime_error("Elliptic curve operation of the base OT failed");
+        }
+    }
+
+    static Group newGroup() {
+        Group group(EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1));
+        if (!group) {
+            throw std::runtime_error("P-256 is not available");
+        }
+        return group;
+    }
+
+    static Point newPoint(const Group& group) { return Point(EC_POINT_new(group.get())); }
+
+    static BigNum randomScalar(const Group& group) {
+        BigNum scalar(BN_new());
+        check(BN_rand_range(scalar.get(), EC_GROUP_get0_order(group.get())));
+        return scalar;
+    }
+
+    static void encode(const Group& group, const Point& point, uint8_t* out, BN_CTX* ctx) {
+        auto size = EC_POINT_point2oct(group.get(), point.get(), POINT_CONVERSION_COMPRESSED, out, kPointSize, ctx);
+        if (size != kPointSize) {
+            throw std::runtime_error("Failed to encode a point of the base OT");
+        }
+    }
+
+    static Point decode(const Group& group, const uint8_t* in, BN_CTX* ctx) {
+        auto point = newPoint(group);
+        check(EC_POINT_oct2point(group.get(), point.get(), in, kPointSize, ctx));
+        return point;
+    }
+
+    // The key of the index-th OT derived from a group element
+    static OTBlock hash(std::size_t index, const Group& group, const Point& point, BN_CTX* ctx) {
+        uint8_t input[sizeof(uint64_t) + kPointSize];
+        auto index64 = static_cast<uint64_t>(index);
+        std::memcpy(input, &index64, sizeof(index64));
+        encode(group, point, input + sizeof(index64), ctx);
+
+        uint8_t digest[EVP_MAX_MD_SIZE];
+        unsigned int digest_size = 0;
+        check(EVP_Digest(input, sizeof(input), digest, &digest_size, EVP_sha256(), nullptr));
+
+        OTBlock key;
+        std::memcpy(&key, digest, sizeof(key));
+        return key;
+    }
+};
+
+
+inline
+std::vector<std::array<OTBlock, 2>> BaseOT::send(Party& party, std::size_t num_ots) {
+    auto group = newGroup();
+    Context ctx(BN_CTX_new());
+
+    // A = aG
+    auto a = randomScalar(group);
+    auto A = newPoint(group);
+    check(EC_POINT_mul(group.get(), A.get(), a.get(), nullptr, nullptr, ctx.get()));
+    std::vector<uint8_t> message(kPointSize);
+    encode(group, A, message.data(), ctx.get());
+    party.SendVecToOther(message);
+
+    // T = aA, so that a(B - A) = aB - T
+    auto T = newPoint(group);
+    check(EC_POINT_mul(group.get(), T.get(), nullptr, A.get(), a.get(), ctx.get()));
+    check(EC_POINT_invert(group.get(), T.get(), ctx.get()));
+
+    auto received = party.ReceiveVecFromOther<uint8_t>(num_ots * kPointSize);
+    std::vector<std::array<OTBlock, 2>> keys(num_ots);
+    for (std::size_t i = 0; i < num_ots; ++i) {
+        auto B = decode(group, received.data() + i * kPointSize, ctx.get());
+        auto aB = newPoint(group);
+        check(EC_POINT_mul(group.get(), aB.get(), nullptr, B.get(), a.get(), ctx.get()));
+        keys[i][0] = hash(i, group, aB, ctx.get());
+        check(EC_POINT_add(group.get(), aB.get(), aB.get(), T.get(), ctx.get()));
+        keys[i][1] = hash(i, group, aB, ctx.get());
+    }
+    return keys;
+}
+
+
+inline
+std::vector<OTBlock> BaseOT::receive(Party& party, const std::vector<bool>& choices) {
+    auto group = newGroup();
+    Context ctx(BN_CTX_new());
+
+    auto A = decode(group, party.ReceiveVecFromOther<uint8_t>(kPointSize).data(), ctx.get());
+
+    // B = bG if the choice is 0, A + bG otherwise; the key is H(bA)
+    std::vector<uint8_t> message(choices.size() * kPointSize);
+    std::vector<OTBlock> keys(choices.size());
+    for (std::size_t i = 0; i < choices.size(); ++i) {
+        auto b = randomScalar(group);
+        auto B = newPoint(group);
+        check(EC_POINT_mul(group.get(), B.get(), b.get(), nullptr, nullptr, ctx.get()));
+        if (choices[i]) {
+            check(EC_POINT_add(group.get(), B.get(), B.get(), A.get(), ctx.get()));
+        }
+        encode(group, B, message.data() + i * kPointSize, ctx.get());
+
+        auto bA = newPoint(group);
+        check(EC_POINT_mul(group.get(), bA.get(), nullptr, A.get(), b.get(), ctx.get()));
+        keys[i] = hash(i, group, bA, ctx.get());
+    }
+    party.SendVecToOther(message);
+    return keys;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_BASEOT_H
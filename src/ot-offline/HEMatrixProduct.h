@@ -0,0 +1,212 @@
+#ifndef BIOAUTH_HEMATRIXPRODUCT_H
+#define BIOAUTH_HEMATRIXPRODUCT_H
+
+#include <bit>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <execution>
+#include <concepts>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include <gmpxx.h>
+
+#include "networking/Party.h"
+#include "ot-offline/Paillier.h"
+
+namespace bioauth {
+
+// The two-party product of matrices over Z_{2^l} under Paillier encryption: the receiver holds X (dim_row x dim_mid)
+// and its key pair, the sender holds Y (dim_mid x dim_col), and afterwards the two outputs add up to X * Y.
+//
+// The receiver sends Enc(x) for each entry of X. For each entry of X * Y, the sender computes Enc(sum_k x_k * y_k)
+// over the integers as prod_k Enc(x_k)^{y_k}, and packs several of them into the slots of one ciphertext,
+// each slot masked by a random r that is 40 bits longer than the value. The receiver decrypts the packed ciphertexts
+// and keeps the slots modulo 2^l, the sender keeps -r.
+//
+// The communication is dim_row * dim_mid ciphertexts one way and (dim_row * dim_col) / (number of slots) the other way,
+// independent of the bit length of the ring, instead of the dim_row * dim_mid * dim_col * l^2 bits of the OT-based
+// product in ot-offline/VectorOLE.h; the price is dim_row * dim_mid * dim_col * l / 8 multiplications modulo n^2.
+
+namespace he_product_detail {
+
+constexpr std::size_t kStatisticalSecurity = 40;
+
+// The bases of a row of X whose exponentiation tables are in memory at the same time, 256 ciphertexts each
+constexpr std::size_t kBasesPerChunk = 256;
+
+template <std::integral T>
+std::size_t slotBits(std::size_t dim_mid) {
+    return 2 * 8 * sizeof(T) + std::bit_width(dim_mid) + kStatisticalSecurity + 1;
+}
+
+template <std::integral T>
+mpz_class toMpz(T value) {
+    mpz_class result;
+    mpz_import(result.get_mpz_t(), 1, -1, sizeof(T), 0, 0, &value);
+    return result;
+}
+
+// The value modulo 2^l, as T
+template <std::integral T>
+T fromMpz(const mpz_class& value) {
+    uint8_t bytes[sizeof(T)] = {};
+    mpz_class low;
+    mpz_fdiv_r_2exp(low.get_mpz_t(), value.get_mpz_t(), 8 * sizeof(T));
+    mpz_export(bytes, nullptr, -1, 1, 0, 0, low.get_mpz_t());
+    T result;
+    std::memcpy(&result, bytes, sizeof(T));
+    return result;
+}
+
+template <class Func>
+void parallelFor(std::size_t n, const Func& f) {
+    std::vector<std::size_t> indices(n);
+    std::iota(indices.begin(), indices.end(), std::size_t(0));
+#ifdef _LIBCPP_HAS_NO_INCOMPLETE_PSTL
+    std::for_each(indices.begin(), indices.end(), f);
+#else
+    std::for_each(std::execution::par, indices.begin(), indices.end(), f);
+#endif
+}
+
+inline
+std::vector<uint8_t> serialize(const std::vector<mpz_class>& ciphertexts) {
+    using paillier_detail::kCiphertextBytes;
+    std::vector<uint8_t> bytes(ciphertexts.size() * kCiphertextBytes);
+    for (std::size_t i = 0; i < ciphertexts.size(); ++i) {
+        paillier_detail::toBytes(ciphertexts[i], bytes.data() + i * kCiphertextBytes, kCiphertextBytes);
+    }
+    return bytes;
+}
+
+inline
+std::vector<mpz_class> deserialize(const std::vector<uint8_t>& bytes) {
+    using paillier_detail::kCiphertextBytes;
+    std::vector<mpz_class> ciphertexts(bytes.size() / kCiphertextBytes);
+    for (std::size_t i = 0; i < ciphertexts.size(); ++i) {
+        ciphertexts[i] = paillier_detail::fromBytes(bytes.data() + i * kCiphertextBytes, kCiphertextBytes);
+    }
+    return ciphertexts;
+}
+
+inline
+std::size_t numSlots(const PaillierPublicKey& key, std::size_t slot_bits) {
+    auto num_slots = key.plaintext_bits() / slot_bits;
+    if (num_slots == 0) {
+        throw std::invalid_argument("The Paillier modulus is too small for the products");
+    }
+    return num_slots;
+}
+
+} // namespace he_product_detail
+
+
+/// The receiver's side, returns its share of X * Y (dim_row x dim_col)
+template <std::integral T>
+std::vector<T> heProductReceive(const PaillierKeyPair& key, Party& party, const std::vector<T>& x,
+                                std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
+    using namespace he_product_detail;
+
+    const auto& public_key = key.public_key();
+    const auto slot_bits = slotBits<T>(dim_mid);
+    const auto num_slots = numSlots(public_key, slot_bits);
+    const auto num_outputs = dim_row * dim_col;
+    const auto num_packed = (num_outputs + num_slots - 1) / num_slots;
+
+    std::vector<mpz_class> encrypted(dim_row * dim_mid);
+    parallelFor(encrypted.size(), [&](std::size_t i) { encrypted[i] = public_key.encrypt(toMpz(x[i])); });
+    party.SendVecToOther(serialize(encrypted));
+
+    auto packed = deserialize(party.ReceiveVecFromOther<uint8_t>(num_packed * paillier_detail::kCiphertextBytes));
+    std::vector<T> output(num_outputs);
+    parallelFor(num_packed, [&](std::size_t p) {
+        auto plaintext = key.decrypt(packed[p]);
+        for (std::size_t s = 0; s < num_slots && p * num_slots + s < num_outputs; ++s) {
+            mpz_class slot;
+            mpz_fdiv_q_2exp(slot.get_mpz_t(), plaintext.get_mpz_t(), s * slot_bits);
+            output[p * num_slots + s] = fromMpz<T>(slot);
+        }
+    });
+    return output;
+}
+
+
+/// The sender's side, returns its share of X * Y (dim_row x dim_col).
+/// other_key is the receiver's public key.
+template <std::integral T>
+std::vector<T> heProductSend(const PaillierPublicKey& other_key, Party& party, const std::vector<T>& y,
+                             std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
+    using namespace he_product_detail;
+
+    const auto slot_bits = slotBits<T>(dim_mid);
+    const auto num_slots = numSlots(other_key, slot_bits);
+    const auto num_outputs = dim_row * dim_col;
+    const auto num_packed = (num_outputs + num_slots - 1) / num_slots;
+
+    auto encrypted = deserialize(
+        party.ReceiveVecFromOther<uint8_t>(dim_row * dim_mid * paillier_detail::kCiphertextBytes));
+
+    // Enc(X * Y) entry by entry, by Straus' simultaneous exponentiation with 8-bit windows,
+    // a chunk of bases of a row at a time
+    std::vector<mpz_class> products(num_outputs, mpz_class(1));
+    std::vector<std::vector<mpz_class>> tables(std::min(kBasesPerChunk, dim_mid));
+    for (std::size_t i = 0; i < dim_row; ++i) {
+        for (std::size_t first = 0; first < dim_mid; first += kBasesPerChunk) {
+            auto count = std::min(kBasesPerChunk, dim_mid - first);
+            parallelFor(count, [&](std::size_t k) {
+                auto& table = tables[k];
+                table.resize(256);
+                table[0] = 1;
+                for (std::size_t v = 1; v < table.size(); ++v) {
+                    table[v] = other_key.mulMod(table[v - 1], encrypted[i * dim_mid + first + k]);
+                }
+            });
+
+            parallelFor(dim_col, [&](std::size_t j) {
+                mpz_class acc = 1;
+                for (std::size_t byte = sizeof(T); byte-- > 0;) {
+                    for (std::size_t b = 0; b < 8 && acc != 1; ++b) {
+                        acc = other_key.mulMod(acc, acc);
+                    }
+                    for (std::size_t k = 0; k < count; ++k) {
+                        auto digit = static_cast<std::size_t>((y[(first + k) * dim_col + j] >> (8 * byte)) & 0xFF);
+                        if (digit != 0)
+                            acc = other_key.mulMod(acc, tables[k][digit]);
+                    }
+                }
+                products[i * dim_col + j] = other_key.mulMod(products[i * dim_col + j], acc);
+            });
+        }
+    }
+
+    // Pack the slots by Horner's rule and add the masks
+    std::vector<mpz_class> packed(num_packed);
+    std::vector<T> output(num_outputs);
+    parallelFor(num_packed, [&](std::size_t p) {
+        auto num_used = std::min(num_slots, num_outputs - p * num_slots);
+        mpz_class acc = 1;
+        mpz_class mask = 0;
+        for (std::size_t s = num_used; s-- > 0;) {
+            for (std::size_t b = 0; b < slot_bits && acc != 1; ++b) {
+                acc = other_key.mulMod(acc, acc);
+            }
+            acc = other_key.mulMod(acc, products[p * num_slots + s]);
+
+            auto r = paillier_detail::randomBits(slot_bits - 1);
+            mask = (mask << slot_bits) + r;
+            output[p * num_slots + s] = T(0) - fromMpz<T>(r);
+        }
+        packed[p] = other_key.add(acc, other_key.encrypt(mask));
+    });
+    party.SendVecToOther(serialize(packed));
+
+    return output;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_HEMATRIXPRODUCT_H
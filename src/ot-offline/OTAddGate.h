@@ -0,0 +1,48 @@
+#ifndef BIOAUTH_OTADDGATE_H
+#define BIOAUTH_OTADDGATE_H
+
+#include <memory>
+#include <stdexcept>
+
+#include "share/IsSpdz2kShare.h"
+#include "utils/linear_algebra.h"
+#include "ot-offline/OTGate.h"
+
+namespace bioauth {
+
+template <IsSpdz2kShare ShrType>
+class OTAddGate : public OTGate<ShrType> {
+public:
+    OTAddGate(const std::shared_ptr<OTGate<ShrType>>& p_input_x, const std::shared_ptr<OTGate<ShrType>>& p_input_y);
+
+private:
+    void doRunOffline() override;
+};
+
+
+template <IsSpdz2kShare ShrType>
+OTAddGate<ShrType>::OTAddGate(const std::shared_ptr<OTGate<ShrType>>& p_input_x,
+                              const std::shared_ptr<OTGate<ShrType>>& p_input_y)
+    : OTGate<ShrType>(p_input_x, p_input_y) {
+    if (p_input_x->dim_row() != p_input_y->dim_row() ||
+        p_input_x->dim_col() != p_input_y->dim_col()) {
+        throw std::invalid_argument("The inputs of addition gate should have the same dimensions");
+    }
+    this->set_dim_row(p_input_x->dim_row());
+    this->set_dim_col(p_input_x->dim_col());
+}
+
+
+template <IsSpdz2kShare ShrType>
+void OTAddGate<ShrType>::doRunOffline() {
+    // $[\lambda_z] = [\lambda_x] + [\lambda_y]$, no interaction needed
+    this->lambda_shr() = matrixAdd(this->input_x()->lambda_shr(), this->input_y()->lambda_shr());
+    this->lambda_shr_mac() = matrixAdd(this->input_x()->lambda_shr_mac(), this->input_y()->lambda_shr_mac());
+
+    this->party().WriteShares(this->lambda_shr());
+    this->party().WriteShares(this->lambda_shr_mac());
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTADDGATE_H
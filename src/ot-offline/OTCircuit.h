@@ -0,0 +1,103 @@
+#ifndef BIOAUTH_OTCIRCUIT_H
+#define BIOAUTH_OTCIRCUIT_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "share/IsSpdz2kShare.h"
+#include "ot-offline/OTParty.h"
+#include "ot-offline/OTGate.h"
+#include "ot-offline/OTInputGate.h"
+#include "ot-offline/OTAddGate.h"
+#include "ot-offline/OTSubtractGate.h"
+#include "ot-offline/OTMultiplyGate.h"
+#include "ot-offline/OTOutputGate.h"
+
+namespace bioauth {
+
+/// The circuit of the OT-based offline phase, both parties build the same circuit as in the online phase.
+/// Only the gates of the (matrix) arithmetic circuits are supported so far.
+template <IsSpdz2kShare ShrType>
+class OTCircuit {
+public:
+    explicit OTCircuit(OTParty<ShrType>& p_party) : party_(p_party) {}
+
+    void runOffline();
+
+    void addEndpoint(const std::shared_ptr<OTGate<ShrType>>& gate) { endpoints_.push_back(gate); }
+
+    std::shared_ptr<OTInputGate<ShrType>>
+    input(std::size_t owner_id, std::size_t dim_row, std::size_t dim_col);
+
+    std::shared_ptr<OTAddGate<ShrType>>
+    add(const std::shared_ptr<OTGate<ShrType>>& input_x, const std::shared_ptr<OTGate<ShrType>>& input_y);
+
+    std::shared_ptr<OTSubtractGate<ShrType>>
+    subtract(const std::shared_ptr<OTGate<ShrType>>& input_x, const std::shared_ptr<OTGate<ShrType>>& input_y);
+
+    std::shared_ptr<OTMultiplyGate<ShrType>>
+    multiply(const std::shared_ptr<OTGate<ShrType>>& input_x, const std::shared_ptr<OTGate<ShrType>>& input_y);
+
+    std::shared_ptr<OTOutputGate<ShrType>>
+    output(const std::shared_ptr<OTGate<ShrType>>& input_x);
+
+    [[nodiscard]] auto& endpoints() { return endpoints_; }
+
+private:
+    OTParty<ShrType>& party_;
+    std::vector<std::shared_ptr<OTGate<ShrType>>> gates_;
+    std::vector<std::shared_ptr<OTGate<ShrType>>> endpoints_;
+};
+
+
+template <IsSpdz2kShare ShrType>
+void OTCircuit<ShrType>::runOffline() {
+    for (const auto& gate : endpoints_) {
+        gate->runOffline();
+    }
+}
+
+template <IsSpdz2kShare ShrType>
+std::shared_ptr<OTInputGate<ShrType>> OTCircuit<ShrType>::
+input(std::size_t owner_id, std::size_t dim_row, std::size_t dim_col) {
+    auto gate = std::make_shared<OTInputGate<ShrType>>(party_, dim_row, dim_col, owner_id);
+    gates_.push_back(gate);
+    return gate;
+}
+
+template <IsSpdz2kShare ShrType>
+std::shared_ptr<OTAddGate<ShrType>> OTCircuit<ShrType>::
+add(const std::shared_ptr<OTGate<ShrType>>& input_x, const std::shared_ptr<OTGate<ShrType>>& input_y) {
+    auto gate = std::make_shared<OTAddGate<ShrType>>(input_x, input_y);
+    gates_.push_back(gate);
+    return gate;
+}
+
+template <IsSpdz2kShare ShrType>
+std::shared_ptr<OTSubtractGate<ShrType>> OTCircuit<ShrType>::
+subtract(const std::shared_ptr<OTGate<ShrType>>& input_x, const std::shared_ptr<OTGate<ShrType>>& input_y) {
+    auto gate = std::make_shared<OTSubtractGate<ShrType>>(input_x, input_y);
+    gates_.push_back(gate);
+    return gate;
+}
+
+template <IsSpdz2kShare ShrType>
+std::shared_ptr<OTMultiplyGate<ShrType>> OTCircuit<ShrType>::
+multiply(const std::shared_ptr<OTGate<ShrType>>& input_x, const std::shared_ptr<OTGate<ShrType>>& input_y) {
+    auto gate = std::make_shared<OTMultiplyGate<ShrType>>(input_x, input_y);
+    gates_.push_back(gate);
+    return gate;
+}
+
+template <IsSpdz2kShare ShrType>
+std::shared_ptr<OTOutputGate<ShrType>> OTCircuit<ShrType>::
+output(const std::shared_ptr<OTGate<ShrType>>& input_x) {
+    auto gate = std::make_shared<OTOutputGate<ShrType>>(input_x);
+    gates_.push_back(gate);
+    return gate;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTCIRCUIT_H
@@ -0,0 +1,250 @@
+#ifndef BIOAUTH_OTEXTENSION_H
+#define BIOAUTH_OTEXTENSION_H
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+
+#include <openssl/evp.h>
+
+#include "networking/Party.h"
+#include "utils/aes_ctr_prg.h"
+#include "utils/bit_slice.h"
+#include "ot-offline/BaseOT.h"
+
+namespace bioauth {
+
+// Random OT extension of Ishai, Kilian, Nissim and Petrank (https://ia.cr/2003/161),
+// secure against semi-honest adversaries.
+//
+// The extension receiver R is the sender of 128 base OTs with keys (k_i^0, k_i^1),
+// the extension sender S receives k_i^{Delta_i} for its random Delta.
+// To extend m OTs with choice bits r, R sends u_i = G(k_i^0) ^ G(k_i^1) ^ r for every i,
+// then column j of the matrices t_i = G(k_i^0) and q_i = G(k_i^{Delta_i}) ^ Delta_i * u_i
+// satisfies q_j = t_j ^ r_j * Delta.
+// Hashing the columns with a tweak breaks the correlation: S gets H(j, q_j) and H(j, q_j ^ Delta),
+// R gets H(j, t_j) = the message of its choice.
+//
+// The generators G keep running across calls, so each call extends fresh OTs.
+
+namespace ot_extension_detail {
+
+constexpr std::size_t kNumBaseOTs = 128;
+
+inline
+AesCtrPrg::Seed toSeed(OTBlock block) {
+    AesCtrPrg::Seed seed;
+    std::memcpy(seed.data(), &block, seed.size());
+    return seed;
+}
+
+// rows holds kNumBaseOTs rows of num_words words each, returns the num_words * 64 columns as blocks
+inline
+std::vector<OTBlock> transposeColumns(const std::vector<uint64_t>& rows, std::size_t num_words) {
+    std::vector<OTBlock> columns(num_words * 64);
+    uint64_t block[64];
+    for (std::size_t w = 0; w < num_words; ++w) {
+        for (std::size_t half = 0; half < 2; ++half) {
+            for (std::size_t r = 0; r < 64; ++r) {
+                block[r] = rows[(half * 64 + r) * num_words + w];
+            }
+            transpose64(block);
+            for (std::size_t c = 0; c < 64; ++c) {
+                columns[w * 64 + c] |= static_cast<OTBlock>(block[c]) << (64 * half);
+            }
+        }
+    }
+    return columns;
+}
+
+/// H(j, x) = AES_k(x ^ j) ^ x ^ j under a fixed public key k
+class TweakedHash {
+public:
+    TweakedHash() : ctx_(EVP_CIPHER_CTX_new()) {
+        static constexpr uint8_t kFixedKey[16] = {0x42, 0x69, 0x6f, 0x41, 0x75, 0x74, 0x68, 0x2d,
+                                                  0x4f, 0x54, 0x2d, 0x68, 0x61, 0x73, 0x68, 0x00};
+        if (ctx_ == nullptr || EVP_EncryptInit_ex(ctx_, EVP_aes_128_ecb(), nullptr, kFixedKey, nullptr) != 1) {
+            EVP_CIPHER_CTX_free(ctx_);
+            throw std::runtime_error("Failed to initialize the hash of the OT extension");
+        }
+        EVP_CIPHER_CTX_set_padding(ctx_, 0);
+    }
+
+    TweakedHash(const TweakedHash&) = delete;
+    TweakedHash& operator=(const TweakedHash&) = delete;
+
+    ~TweakedHash() { EVP_CIPHER_CTX_free(ctx_); }
+
+    /// Hash blocks[j] with tweak first_tweak + j, in place
+    void operator()(std::vector<OTBlock>& blocks, uint64_t first_tweak) {
+        for (std::size_t j = 0; j < blocks.size(); ++j) {
+            blocks[j] ^= static_cast<OTBlock>(first_tweak + j);
+        }
+        std::vector<OTBlock> encrypted(blocks.size());
+        auto* in = reinterpret_cast<const uint8_t*>(blocks.data());
+        auto* out = reinterpret_cast<uint8_t*>(encrypted.data());
+        std::size_t remaining = blocks.size() * sizeof(OTBlock);
+        constexpr std::size_t kMaxChunk = (INT_MAX / 2) & ~std::size_t{15};
+        while (remaining > 0) {
+            auto chunk = std::min(remaining, kMaxChunk);
+            int out_len = 0;
+            if (EVP_EncryptUpdate(ctx_, out, &out_len, in, static_cast<int>(chunk)) != 1) {
+                throw std::runtime_error("AES encryption of the OT extension failed");
+            }
+            in += chunk;
+            out += chunk;
+            remaining -= chunk;
+        }
+        for (std::size_t j = 0; j < blocks.size(); ++j) {
+            blocks[j] ^= encrypted[j];
+        }
+    }
+
+private:
+    EVP_CIPHER_CTX* ctx_;
+};
+
+} // namespace ot_extension_detail
+
+
+/// The sender of the extended random OTs, it is paired with the other party's IknpReceiver
+class IknpSender {
+public:
+    explicit IknpSender(Party& party);
+
+    /// num_ots random OTs, the receiver gets messages[j][r_j]
+    std::vector<std::array<OTBlock, 2>> extend(std::size_t num_ots);
+
+private:
+    Party& party_;
+    OTBlock delta_ = 0;
+    std::vector<std::unique_ptr<AesCtrPrg>> prgs_;
+    ot_extension_detail::TweakedHash hash_;
+    uint64_t num_extended_ = 0;
+};
+
+
+/// The receiver of the extended random OTs, it is paired with the other party's IknpSender
+class IknpReceiver {
+public:
+    explicit IknpReceiver(Party& party);
+
+    /// Random OTs with the given choice bits, returns the chosen messages
+    std::vector<OTBlock> extend(const std::vector<bool>& choices);
+
+private:
+    Party& party_;
+    std::vector<std::array<std::unique_ptr<AesCtrPrg>, 2>> prgs_;
+    ot_extension_detail::TweakedHash hash_;
+    uint64_t num_extended_ = 0;
+};
+
+
+inline
+IknpSender::IknpSender(Party& party) : party_(party) {
+    using namespace ot_extension_detail;
+
+    std::vector<bool> choices(kNumBaseOTs);
+    auto random = getRand<OTBlock>();
+    for (std::size_t i = 0; i < kNumBaseOTs; ++i) {
+        choices[i] = (random >> i) & 1;
+    }
+    delta_ = random;
+
+    auto keys = BaseOT::receive(party_, choices);
+    for (auto key : keys) {
+        prgs_.push_back(std::make_unique<AesCtrPrg>(toSeed(key)));
+    }
+}
+
+
+inline
+std::vector<std::array<OTBlock, 2>> IknpSender::extend(std::size_t num_ots) {
+    using namespace ot_extension_detail;
+
+    auto num_words = (num_ots + 127) / 128 * 2;
+    auto u = party_.ReceiveVecFromOther<uint64_t>(kNumBaseOTs * num_words);
+
+    // q_i = G(k_i^{Delta_i}) ^ Delta_i * u_i
+    std::vector<uint64_t> q(kNumBaseOTs * num_words);
+    for (std::size_t i = 0; i < kNumBaseOTs; ++i) {
+        auto* row = q.data() + i * num_words;
+        prgs_[i]->fill(row, num_words * sizeof(uint64_t));
+        if ((delta_ >> i) & 1) {
+            for (std::size_t w = 0; w < num_words; ++w) {
+                row[w] ^= u[i * num_words + w];
+            }
+        }
+    }
+
+    auto q_columns = transposeColumns(q, num_words);
+    q_columns.resize(num_ots);
+    auto q_delta = q_columns;
+    for (auto& column : q_delta) {
+        column ^= delta_;
+    }
+    hash_(q_columns, num_extended_);
+    hash_(q_delta, num_extended_);
+    num_extended_ += num_ots;
+
+    std::vector<std::array<OTBlock, 2>> messages(num_ots);
+    for (std::size_t j = 0; j < num_ots; ++j) {
+        messages[j] = {q_columns[j], q_delta[j]};
+    }
+    return messages;
+}
+
+
+inline
+IknpReceiver::IknpReceiver(Party& party) : party_(party) {
+    using namespace ot_extension_detail;
+
+    auto keys = BaseOT::send(party_, kNumBaseOTs);
+    for (const auto& key_pair : keys) {
+        prgs_.push_back({std::make_unique<AesCtrPrg>(toSeed(key_pair[0])),
+                         std::make_unique<AesCtrPrg>(toSeed(key_pair[1]))});
+    }
+}
+
+
+inline
+std::vector<OTBlock> IknpReceiver::extend(const std::vector<bool>& choices) {
+    using namespace ot_extension_detail;
+
+    auto num_ots = choices.size();
+    auto num_words = (num_ots + 127) / 128 * 2;
+
+    std::vector<uint64_t> r(num_words);
+    for (std::size_t j = 0; j < num_ots; ++j) {
+        r[j / 64] |= static_cast<uint64_t>(choices[j]) << (j % 64);
+    }
+
+    // t_i = G(k_i^0), u_i = t_i ^ G(k_i^1) ^ r
+    std::vector<uint64_t> t(kNumBaseOTs * num_words);
+    std::vector<uint64_t> u(kNumBaseOTs * num_words);
+    for (std::size_t i = 0; i < kNumBaseOTs; ++i) {
+        auto* t_row = t.data() + i * num_words;
+        auto* u_row = u.data() + i * num_words;
+        prgs_[i][0]->fill(t_row, num_words * sizeof(uint64_t));
+        prgs_[i][1]->fill(u_row, num_words * sizeof(uint64_t));
+        for (std::size_t w = 0; w < num_words; ++w) {
+            u_row[w] ^= t_row[w] ^ r[w];
+        }
+    }
+    party_.SendVecToOther(u);
+
+    auto t_columns = transposeColumns(t, num_words);
+    t_columns.resize(num_ots);
+    hash_(t_columns, num_extended_);
+    num_extended_ += num_ots;
+    return t_columns;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTEXTENSION_H
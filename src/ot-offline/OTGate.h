@@ -0,0 +1,86 @@
+#ifndef BIOAUTH_OTGATE_H
+#define BIOAUTH_OTGATE_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "share/IsSpdz2kShare.h"
+#include "ot-offline/OTParty.h"
+
+namespace bioauth {
+
+/// A gate of the OT-based offline phase.
+/// Unlike FakeGate, it only holds this party's shares, and the parties generate the data together.
+template <IsSpdz2kShare ShrType>
+class OTGate {
+public:
+    using ClearType = typename ShrType::ClearType;
+    using SemiShrType = typename ShrType::SemiShrType;
+
+    OTGate(OTParty<ShrType>& p_party, std::size_t p_dim_row, std::size_t p_dim_col)
+        : party_(p_party), dim_row_(p_dim_row), dim_col_(p_dim_col) {}
+
+    OTGate(const std::shared_ptr<OTGate>& p_input_x, const std::shared_ptr<OTGate>& p_input_y)
+        : party_(p_input_x->party_), input_x_(p_input_x), input_y_(p_input_y) {}
+
+    virtual ~OTGate() = default;
+
+    void runOffline();
+
+    [[nodiscard]] const auto& input_x() const { return input_x_; }
+    [[nodiscard]] const auto& input_y() const { return input_y_; }
+
+    [[nodiscard]] auto dim_row() const { return dim_row_; }
+    [[nodiscard]] auto dim_col() const { return dim_col_; }
+
+    [[nodiscard]] auto& party() { return party_; }
+
+    [[nodiscard]] auto& lambda_shr() { return lambda_shr_; }
+    [[nodiscard]] const auto& lambda_shr() const { return lambda_shr_; }
+
+    [[nodiscard]] auto& lambda_shr_mac() { return lambda_shr_mac_; }
+    [[nodiscard]] const auto& lambda_shr_mac() const { return lambda_shr_mac_; }
+
+protected:
+    void set_dim_row(std::size_t p_dim_row) { dim_row_ = p_dim_row; }
+    void set_dim_col(std::size_t p_dim_col) { dim_col_ = p_dim_col; }
+
+private:
+    virtual void doRunOffline() = 0;
+
+    bool evaluated_offline_ = false;
+
+    OTParty<ShrType>& party_;
+
+    std::shared_ptr<OTGate> input_x_{};
+    std::shared_ptr<OTGate> input_y_{};
+
+    std::size_t dim_row_ = 1;
+    std::size_t dim_col_ = 1;
+
+    // This party's shares of $\lambda_z$ and of its MAC
+    std::vector<SemiShrType> lambda_shr_;
+    std::vector<SemiShrType> lambda_shr_mac_;
+};
+
+
+template <IsSpdz2kShare ShrType>
+void OTGate<ShrType>::runOffline() {
+    if (this->evaluated_offline_)
+        return;
+
+    // Same order as FakeGate::runOffline, so that the data are in the order the online gates read them
+    if (input_x_ && !input_x_->evaluated_offline_)
+        input_x_->runOffline();
+    if (input_y_ && !input_y_->evaluated_offline_)
+        input_y_->runOffline();
+
+    this->doRunOffline();
+
+    this->evaluated_offline_ = true;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTGATE_H
@@ -0,0 +1,44 @@
+#ifndef BIOAUTH_OTINPUTGATE_H
+#define BIOAUTH_OTINPUTGATE_H
+
+#include <memory>
+#include <vector>
+
+#include "share/IsSpdz2kShare.h"
+#include "ot-offline/OTGate.h"
+
+namespace bioauth {
+
+template <IsSpdz2kShare ShrType>
+class OTInputGate : public OTGate<ShrType> {
+public:
+    OTInputGate(OTParty<ShrType>& p_party, std::size_t p_dim_row, std::size_t p_dim_col, std::size_t p_owner_id)
+        : OTGate<ShrType>(p_party, p_dim_row, p_dim_col), owner_id_(p_owner_id) {}
+
+private:
+    void doRunOffline() override;
+
+    std::size_t owner_id_;
+};
+
+
+template <IsSpdz2kShare ShrType>
+void OTInputGate<ShrType>::doRunOffline() {
+    auto size = this->dim_row() * this->dim_col();
+
+    // $[\lambda]$-values are uniformly random
+    this->lambda_shr() = this->party().RandomShares(size);
+    this->lambda_shr_mac() = this->party().Authenticate(this->lambda_shr());
+
+    // The owner should know lambda_clear
+    auto lambda_clear = this->party().OpenTo(owner_id_, this->lambda_shr());
+    if (this->party().my_id() == owner_id_) {
+        this->party().WriteClear(lambda_clear);
+    }
+    this->party().WriteShares(this->lambda_shr());
+    this->party().WriteShares(this->lambda_shr_mac());
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTINPUTGATE_H
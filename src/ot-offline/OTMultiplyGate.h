@@ -0,0 +1,75 @@
+#ifndef BIOAUTH_OTMULTIPLYGATE_H
+#define BIOAUTH_OTMULTIPLYGATE_H
+
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include "share/IsSpdz2kShare.h"
+#include "utils/linear_algebra.h"
+#include "ot-offline/OTGate.h"
+
+namespace bioauth {
+
+template <IsSpdz2kShare ShrType>
+class OTMultiplyGate : public OTGate<ShrType> {
+public:
+    OTMultiplyGate(const std::shared_ptr<OTGate<ShrType>>& p_input_x,
+                   const std::shared_ptr<OTGate<ShrType>>& p_input_y);
+
+    [[nodiscard]] auto dim_mid() const { return dim_mid_; }
+
+private:
+    void doRunOffline() override;
+
+    std::size_t dim_mid_;
+};
+
+
+template <IsSpdz2kShare ShrType>
+OTMultiplyGate<ShrType>::OTMultiplyGate(const std::shared_ptr<OTGate<ShrType>>& p_input_x,
+                                        const std::shared_ptr<OTGate<ShrType>>& p_input_y)
+    : OTGate<ShrType>(p_input_x, p_input_y), dim_mid_(p_input_x->dim_col()) {
+    if (p_input_x->dim_col() != p_input_y->dim_row()) {
+        throw std::invalid_argument("The inputs of multiplication gate should have compatible dimensions");
+    }
+    this->set_dim_row(p_input_x->dim_row());
+    this->set_dim_col(p_input_y->dim_col());
+}
+
+
+template <IsSpdz2kShare ShrType>
+void OTMultiplyGate<ShrType>::doRunOffline() {
+    auto& party = this->party();
+    auto size_lhs = this->dim_row() * this->dim_mid();
+    auto size_rhs = this->dim_mid() * this->dim_col();
+    auto size_output = this->dim_row() * this->dim_col();
+
+    // The matrix triple [c] = [a] * [b]
+    auto a_shr = party.RandomShares(size_lhs);
+    auto b_shr = party.RandomShares(size_rhs);
+    auto c_shr = party.Multiply(a_shr, b_shr, this->dim_row(), this->dim_mid(), this->dim_col());
+
+    this->lambda_shr() = party.RandomShares(size_output);
+
+    // $\delta_x = a - \lambda_x$, $\delta_y = b - \lambda_y$ are public
+    auto delta_x_clear = party.Open(matrixSubtract(a_shr, this->input_x()->lambda_shr()));
+    auto delta_y_clear = party.Open(matrixSubtract(b_shr, this->input_y()->lambda_shr()));
+
+    // Same layout as FakeMultiplyGate writes and MultiplyGate reads
+    party.WriteShares(a_shr);
+    party.WriteShares(party.Authenticate(a_shr));
+    party.WriteShares(b_shr);
+    party.WriteShares(party.Authenticate(b_shr));
+    party.WriteShares(c_shr);
+    party.WriteShares(party.Authenticate(c_shr));
+    this->lambda_shr_mac() = party.Authenticate(this->lambda_shr());
+    party.WriteShares(this->lambda_shr());
+    party.WriteShares(this->lambda_shr_mac());
+    party.WriteClear(delta_x_clear);
+    party.WriteClear(delta_y_clear);
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTMULTIPLYGATE_H
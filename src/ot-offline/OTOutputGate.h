@@ -0,0 +1,26 @@
+#ifndef BIOAUTH_OTOUTPUTGATE_H
+#define BIOAUTH_OTOUTPUTGATE_H
+
+#include <memory>
+
+#include "share/IsSpdz2kShare.h"
+#include "ot-offline/OTGate.h"
+
+namespace bioauth {
+
+template <IsSpdz2kShare ShrType>
+class OTOutputGate : public OTGate<ShrType> {
+public:
+    explicit OTOutputGate(const std::shared_ptr<OTGate<ShrType>>& p_input_x)
+        : OTGate<ShrType>(p_input_x, nullptr) {
+        this->set_dim_row(p_input_x->dim_row());
+        this->set_dim_col(p_input_x->dim_col());
+    }
+
+private:
+    void doRunOffline() override {} // Do nothing
+};
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTOUTPUTGATE_H
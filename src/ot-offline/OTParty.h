@@ -0,0 +1,251 @@
+#ifndef BIOAUTH_OTPARTY_H
+#define BIOAUTH_OTPARTY_H
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+#include "share/IsSpdz2kShare.h"
+#include "networking/Party.h"
+#include "utils/rand.h"
+#include "utils/linear_algebra.h"
+#include "utils/preprocessing_file.h"
+#include "ot-offline/OTExtension.h"
+#include "ot-offline/VectorOLE.h"
+#include "ot-offline/Paillier.h"
+#include "ot-offline/HEMatrixProduct.h"
+
+namespace bioauth {
+
+/// How OTParty computes the cross terms of the matrix triples
+enum class TripleBackend {
+    kOT,      // Gilboa's OT-based product, see ot-offline/VectorOLE.h
+    kPaillier // packed Paillier encryption, see ot-offline/HEMatrixProduct.h
+};
+
+/// One of the two parties of the OT-based offline phase.
+/// Together with the other party it generates the preprocessing data that a FakeParty would deal,
+/// and writes its own part to "<job_name>-party-<id>.bin", which PartyWithFakeOffline reads.
+///
+/// The values are additively shared in Z_{2^(k+s)} and authenticated with MACs under a shared key,
+/// as in SPDZ2k (https://ia.cr/2018/482), but the products come from Gilboa's OT-based multiplication
+/// (see ot-offline/VectorOLE.h) or from packed Paillier encryption (see ot-offline/HEMatrixProduct.h), without the consistency checks and the sacrifice step,
+/// so the generated data are only secure against semi-honest parties.
+template <IsSpdz2kShare ShrType>
+class OTParty : public Party {
+public:
+    using ClearType = typename ShrType::ClearType;
+    using KeyShrType = typename ShrType::KeyShrType;
+    using GlobalKeyType = typename ShrType::GlobalKeyType;
+    using SemiShrType = typename ShrType::SemiShrType;
+
+    OTParty(std::size_t p_my_id, std::size_t p_num_parties, std::size_t p_port, const std::string& job_name,
+            TripleBackend p_backend = TripleBackend::kOT);
+
+    [[nodiscard]] KeyShrType key_shr() const { return key_shr_; }
+
+    /// Shares of a uniformly random vector, each party picks its shares locally
+    std::vector<SemiShrType> RandomShares(std::size_t num_elements) const;
+
+    /// Shares of X * Y from shares of X (dim_row x dim_mid) and Y (dim_mid x dim_col)
+    std::vector<SemiShrType> Multiply(const std::vector<SemiShrType>& x, const std::vector<SemiShrType>& y,
+                                      std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col);
+
+    /// Shares of the MACs of the shared values
+    std::vector<SemiShrType> Authenticate(const std::vector<SemiShrType>& shares);
+
+    /// Both parties learn the values (modulo 2^k)
+    std::vector<ClearType> Open(const std::vector<SemiShrType>& shares);
+
+    /// Only owner_id learns the values (modulo 2^k), the other party gets an empty vector
+    std::vector<ClearType> OpenTo(std::size_t owner_id, const std::vector<SemiShrType>& shares);
+
+    void WriteShares(const std::vector<SemiShrType>& shares);
+    void WriteClear(const std::vector<ClearType>& values);
+
+    /// Number of scalar multiplication triples generated so far, a dim_row x dim_mid x dim_col matrix triple
+    /// counts as dim_row * dim_mid * dim_col of them
+    [[nodiscard]] std::size_t num_triples() const { return num_triples_; }
+
+    /// Time spent in Multiply
+    [[nodiscard]] double multiply_seconds() const { return multiply_seconds_; }
+
+private:
+    inline static const std::filesystem::path kFakeOfflineDir{FAKE_OFFLINE_DIR}; // The macro is in CMakeLists.txt
+
+    // The products X_mine * Y_other and X_other * Y_mine, in the order both parties agree on
+    template <class ReceiveFunc, class SendFunc>
+    void crossTerms(const ReceiveFunc& as_receiver, const SendFunc& as_sender);
+
+    KeyShrType key_shr_;
+    TripleBackend backend_;
+    std::unique_ptr<IknpSender> ot_sender_;
+    std::unique_ptr<IknpReceiver> ot_receiver_;
+    std::unique_ptr<PaillierKeyPair> paillier_key_;
+    std::unique_ptr<PaillierPublicKey> other_paillier_key_;
+    std::unique_ptr<PreprocessingWriter> output_file_;
+
+    std::size_t num_triples_ = 0;
+    double multiply_seconds_ = 0;
+};
+
+
+template <IsSpdz2kShare ShrType>
+OTParty<ShrType>::OTParty(std::size_t p_my_id, std::size_t p_num_parties, std::size_t p_port,
+                          const std::string& job_name, TripleBackend p_backend)
+    : Party(p_my_id, p_num_parties, p_port), key_shr_(getRand<KeyShrType>()), backend_(p_backend) {
+    if (p_num_parties != 2) {
+        throw std::invalid_argument("The OT-based offline phase supports two parties only");
+    }
+
+    // Party 0's sender is paired with party 1's receiver, and vice versa
+    if (my_id() == 0) {
+        ot_sender_ = std::make_unique<IknpSender>(*this);
+        ot_receiver_ = std::make_unique<IknpReceiver>(*this);
+    } else {
+        ot_receiver_ = std::make_unique<IknpReceiver>(*this);
+        ot_sender_ = std::make_unique<IknpSender>(*this);
+    }
+
+    // Each party encrypts its own matrices under its own key, and computes on the other party's ciphertexts
+    if (backend_ == TripleBackend::kPaillier) {
+        using paillier_detail::kCiphertextBytes;
+        paillier_key_ = std::make_unique<PaillierKeyPair>();
+        std::vector<uint8_t> my_key(2 * kCiphertextBytes);
+        paillier_detail::toBytes(paillier_key_->public_key().n(), my_key.data(), kCiphertextBytes);
+        paillier_detail::toBytes(paillier_key_->public_key().h_s(), my_key.data() + kCiphertextBytes, kCiphertextBytes);
+
+        std::thread t1([this, &my_key] { SendVecToOther(my_key); });
+        auto other_key = ReceiveVecFromOther<uint8_t>(2 * kCiphertextBytes);
+        t1.join();
+        other_paillier_key_ = std::make_unique<PaillierPublicKey>(
+            paillier_detail::fromBytes(other_key.data(), kCiphertextBytes),
+            paillier_detail::fromBytes(other_key.data() + kCiphertextBytes, kCiphertextBytes));
+    }
+
+    if (!exists(kFakeOfflineDir)) {
+        create_directory(kFakeOfflineDir);
+    }
+    std::string file_name = job_name + (job_name.empty() ? "party-" : "-party-") + std::to_string(my_id()) + ".bin";
+    output_file_ = std::make_unique<PreprocessingWriter>(kFakeOfflineDir / file_name);
+    output_file_->write(SectionKind::kKey, std::span<const KeyShrType>(&key_shr_, 1));
+}
+
+
+template <IsSpdz2kShare ShrType>
+std::vector<typename OTParty<ShrType>::SemiShrType> OTParty<ShrType>::
+RandomShares(std::size_t num_elements) const {
+    std::vector<SemiShrType> shares(num_elements);
+    std::ranges::generate(shares, getRand<SemiShrType>);
+    return shares;
+}
+
+
+template <IsSpdz2kShare ShrType>
+template <class ReceiveFunc, class SendFunc>
+void OTParty<ShrType>::crossTerms(const ReceiveFunc& as_receiver, const SendFunc& as_sender) {
+    if (my_id() == 0) {
+        as_receiver();
+        as_sender();
+    } else {
+        as_sender();
+        as_receiver();
+    }
+}
+
+
+template <IsSpdz2kShare ShrType>
+std::vector<typename OTParty<ShrType>::SemiShrType> OTParty<ShrType>::
+Multiply(const std::vector<SemiShrType>& x, const std::vector<SemiShrType>& y,
+         std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
+    auto start = std::chrono::steady_clock::now();
+    constexpr auto num_bits = 8 * sizeof(SemiShrType);
+
+    // X * Y = X_0 * Y_0 + X_1 * Y_1 + X_0 * Y_1 + X_1 * Y_0
+    auto z = matrixMultiply(x, y, dim_row, dim_mid, dim_col);
+    if (backend_ == TripleBackend::kPaillier) {
+        crossTerms(
+            [&] { matrixAddAssign(z, heProductReceive(*paillier_key_, *this, x, dim_row, dim_mid, dim_col)); },
+            [&] { matrixAddAssign(z, heProductSend(*other_paillier_key_, *this, y, dim_row, dim_mid, dim_col)); });
+    } else {
+        crossTerms(
+            [&] { matrixAddAssign(z, gilboaReceive(*ot_receiver_, *this, x, dim_row, dim_mid, dim_col, num_bits)); },
+            [&] { matrixAddAssign(z, gilboaSend(*ot_sender_, *this, y, dim_row, dim_mid, dim_col, num_bits)); });
+    }
+
+    num_triples_ += dim_row * dim_mid * dim_col;
+    multiply_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return z;
+}
+
+
+template <IsSpdz2kShare ShrType>
+std::vector<typename OTParty<ShrType>::SemiShrType> OTParty<ShrType>::
+Authenticate(const std::vector<SemiShrType>& shares) {
+    constexpr auto num_bits = 8 * sizeof(KeyShrType);
+    const std::vector<SemiShrType> key{static_cast<SemiShrType>(key_shr_)};
+    auto size = shares.size();
+
+    // key * x = key_0 * x_0 + key_1 * x_1 + key_0 * x_1 + key_1 * x_0, the key is the 1 x 1 matrix
+    auto macs = matrixScalar(shares, key.front());
+    crossTerms(
+        [&] { matrixAddAssign(macs, gilboaReceive(*ot_receiver_, *this, key, 1, 1, size, num_bits)); },
+        [&] { matrixAddAssign(macs, gilboaSend(*ot_sender_, *this, shares, 1, 1, size, num_bits)); });
+    return macs;
+}
+
+
+template <IsSpdz2kShare ShrType>
+std::vector<typename OTParty<ShrType>::ClearType> OTParty<ShrType>::
+Open(const std::vector<SemiShrType>& shares) {
+    std::vector<SemiShrType> others;
+    std::thread t1([this, &shares] { SendVecToOther(shares); });
+    others = ReceiveVecFromOther<SemiShrType>(shares.size());
+    t1.join();
+
+    std::vector<ClearType> values(shares.size());
+    for (std::size_t i = 0; i < shares.size(); ++i) {
+        values[i] = static_cast<ClearType>(shares[i] + others[i]);
+    }
+    return values;
+}
+
+
+template <IsSpdz2kShare ShrType>
+std::vector<typename OTParty<ShrType>::ClearType> OTParty<ShrType>::
+OpenTo(std::size_t owner_id, const std::vector<SemiShrType>& shares) {
+    if (my_id() != owner_id) {
+        SendVecToOther(shares);
+        return {};
+    }
+
+    auto others = ReceiveVecFromOther<SemiShrType>(shares.size());
+    std::vector<ClearType> values(shares.size());
+    for (std::size_t i = 0; i < shares.size(); ++i) {
+        values[i] = static_cast<ClearType>(shares[i] + others[i]);
+    }
+    return values;
+}
+
+
+template <IsSpdz2kShare ShrType>
+void OTParty<ShrType>::WriteShares(const std::vector<SemiShrType>& shares) {
+    output_file_->write(SectionKind::kShares, shares);
+}
+
+
+template <IsSpdz2kShare ShrType>
+void OTParty<ShrType>::WriteClear(const std::vector<ClearType>& values) {
+    output_file_->write(SectionKind::kClear, values);
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_OTPARTY_H
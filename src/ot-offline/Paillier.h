@@ -0,0 +1,234 @@
+#ifndef BIOAUTH_PAILLIER_H
+#define BIOAUTH_PAILLIER_H
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include <gmpxx.h>
+#include <openssl/bn.h>
+#include <openssl/rand.h>
+
+namespace bioauth {
+
+// Paillier encryption (https://doi.org/10.1007/3-540-48910-X_16) with g = n + 1,
+// and the randomness h_s^alpha of Damgard, Jurik and Nielsen (https://ia.cr/2008/003):
+// h_s = (-x^2)^n for a random x, and alpha is much shorter than n, so that with a fixed-base table
+// an encryption costs a few dozen multiplications instead of an exponentiation by n.
+
+namespace paillier_detail {
+
+constexpr std::size_t kModulusBits = 2048;
+constexpr std::size_t kCiphertextBytes = 2 * kModulusBits / 8;
+constexpr std::size_t kRandomnessBits = 400;
+constexpr std::size_t kWindowBits = 8;
+constexpr std::size_t kNumWindows = (kRandomnessBits + kWindowBits - 1) / kWindowBits;
+
+/// A uniformly random integer in [0, 2^num_bits)
+inline
+mpz_class randomBits(std::size_t num_bits) {
+    std::vector<uint8_t> bytes((num_bits + 7) / 8);
+    if (RAND_bytes(bytes.data(), static_cast<int>(bytes.size())) != 1) {
+        throw std::runtime_error("Failed to generate random bytes for Paillier");
+    }
+    mpz_class value;
+    mpz_import(value.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+    mpz_fdiv_r_2exp(value.get_mpz_t(), value.get_mpz_t(), num_bits);
+    return value;
+}
+
+inline
+mpz_class randomPrime(std::size_t num_bits) {
+    std::unique_ptr<BIGNUM, decltype(&BN_free)> prime(BN_new(), BN_free);
+    if (!prime || BN_generate_prime_ex(prime.get(), static_cast<int>(num_bits), 0, nullptr, nullptr, nullptr) != 1) {
+        throw std::runtime_error("Failed to generate a prime for Paillier");
+    }
+    std::vector<uint8_t> bytes(BN_num_bytes(prime.get()));
+    BN_bn2bin(prime.get(), bytes.data());
+    mpz_class value;
+    mpz_import(value.get_mpz_t(), bytes.size(), 1, 1, 0, 0, bytes.data());
+    return value;
+}
+
+/// Writes value (which should be less than 2^(8 * size)) to out in size bytes, little-endian
+inline
+void toBytes(const mpz_class& value, uint8_t* out, std::size_t size) {
+    std::fill(out, out + size, 0);
+    std::size_t count = 0;
+    mpz_export(out, &count, -1, 1, 0, 0, value.get_mpz_t());
+    if (count > size) {
+        throw std::length_error("The integer does not fit in the buffer");
+    }
+}
+
+inline
+mpz_class fromBytes(const uint8_t* in, std::size_t size) {
+    mpz_class value;
+    mpz_import(value.get_mpz_t(), size, -1, 1, 0, 0, in);
+    return value;
+}
+
+} // namespace paillier_detail
+
+
+/// The public key (n, h_s), enough to encrypt and to compute on ciphertexts
+class PaillierPublicKey {
+public:
+    PaillierPublicKey(const mpz_class& n, const mpz_class& h_s);
+
+    [[nodiscard]] const mpz_class& n() const { return n_; }
+    [[nodiscard]] const mpz_class& n_squared() const { return n_squared_; }
+    [[nodiscard]] const mpz_class& h_s() const { return h_s_; }
+
+    /// Enc(m) = (1 + m * n) * h_s^alpha mod n^2, for 0 <= m < n
+    [[nodiscard]] mpz_class encrypt(const mpz_class& plaintext) const;
+
+    /// Enc(m_1 + m_2)
+    [[nodiscard]] mpz_class add(const mpz_class& c_1, const mpz_class& c_2) const {
+        return mulMod(c_1, c_2);
+    }
+
+    [[nodiscard]] mpz_class mulMod(const mpz_class& a, const mpz_class& b) const {
+        mpz_class product = a * b;
+        mpz_mod(product.get_mpz_t(), product.get_mpz_t(), n_squared_.get_mpz_t());
+        return product;
+    }
+
+    /// The number of bits of a plaintext that never wraps around n
+    [[nodiscard]] std::size_t plaintext_bits() const { return mpz_sizeinbase(n_.get_mpz_t(), 2) - 1; }
+
+private:
+    mpz_class n_;
+    mpz_class n_squared_;
+    mpz_class h_s_;
+
+    // table_[i][v] = h_s^(v * 2^(kWindowBits * i))
+    std::vector<std::vector<mpz_class>> table_;
+};
+
+
+/// A key pair, the secret key decrypts with the CRT
+class PaillierKeyPair {
+public:
+    PaillierKeyPair();
+
+    [[nodiscard]] const PaillierPublicKey& public_key() const { return *public_key_; }
+
+    [[nodiscard]] mpz_class decrypt(const mpz_class& ciphertext) const;
+
+private:
+    // m mod prime from c^(prime - 1) mod prime^2
+    [[nodiscard]] mpz_class decryptModPrime(const mpz_class& ciphertext, const mpz_class& prime,
+                                            const mpz_class& prime_squared, const mpz_class& h) const;
+
+    mpz_class p_, q_;
+    mpz_class p_squared_, q_squared_;
+    mpz_class h_p_, h_q_; // L_p(g^(p - 1) mod p^2)^(-1) mod p, the same for q
+    mpz_class q_inv_p_;   // q^(-1) mod p
+    std::unique_ptr<PaillierPublicKey> public_key_;
+};
+
+
+inline
+PaillierPublicKey::PaillierPublicKey(const mpz_class& n, const mpz_class& h_s)
+    : n_(n), n_squared_(n * n), h_s_(h_s) {
+    using namespace paillier_detail;
+
+    table_.resize(kNumWindows);
+    mpz_class base = h_s_;
+    for (auto& row : table_) {
+        row.resize(std::size_t{1} << kWindowBits);
+        row[0] = 1;
+        for (std::size_t v = 1; v < row.size(); ++v) {
+            row[v] = mulMod(row[v - 1], base);
+        }
+        base = mulMod(row.back(), base); // base^(2^kWindowBits)
+    }
+}
+
+
+inline
+mpz_class PaillierPublicKey::encrypt(const mpz_class& plaintext) const {
+    using namespace paillier_detail;
+
+    auto alpha = randomBits(kRandomnessBits);
+    std::vector<uint8_t> digits(kNumWindows * kWindowBits / 8);
+    toBytes(alpha, digits.data(), digits.size());
+
+    mpz_class randomness = 1;
+    for (std::size_t i = 0; i < kNumWindows; ++i) {
+        if (digits[i] != 0)
+            randomness = mulMod(randomness, table_[i][digits[i]]);
+    }
+
+    mpz_class ciphertext = plaintext * n_ + 1;
+    return mulMod(ciphertext, randomness);
+}
+
+
+inline
+PaillierKeyPair::PaillierKeyPair() {
+    using namespace paillier_detail;
+
+    do {
+        p_ = randomPrime(kModulusBits / 2);
+        q_ = randomPrime(kModulusBits / 2);
+    } while (p_ == q_);
+
+    mpz_class n = p_ * q_;
+    p_squared_ = p_ * p_;
+    q_squared_ = q_ * q_;
+
+    // g = n + 1, so g^(p - 1) = 1 + (p - 1) * n mod p^2 and L_p of it is (p - 1) * q mod p
+    mpz_class g = n + 1;
+    for (auto [prime, prime_squared, h] : {std::tie(p_, p_squared_, h_p_), std::tie(q_, q_squared_, h_q_)}) {
+        mpz_class u;
+        mpz_class exponent = prime - 1;
+        mpz_powm(u.get_mpz_t(), g.get_mpz_t(), exponent.get_mpz_t(), prime_squared.get_mpz_t());
+        u = (u - 1) / prime;
+        mpz_invert(h.get_mpz_t(), u.get_mpz_t(), prime.get_mpz_t());
+    }
+    mpz_invert(q_inv_p_.get_mpz_t(), q_.get_mpz_t(), p_.get_mpz_t());
+
+    // h_s = (-x^2)^n mod n^2
+    mpz_class x = randomBits(kModulusBits) % n;
+    mpz_class h = n - (x * x) % n;
+    mpz_class h_s;
+    mpz_class n_squared = n * n;
+    mpz_powm(h_s.get_mpz_t(), h.get_mpz_t(), n.get_mpz_t(), n_squared.get_mpz_t());
+
+    public_key_ = std::make_unique<PaillierPublicKey>(n, h_s);
+}
+
+
+inline
+mpz_class PaillierKeyPair::decryptModPrime(const mpz_class& ciphertext, const mpz_class& prime,
+                                           const mpz_class& prime_squared, const mpz_class& h) const {
+    mpz_class u;
+    mpz_class c = ciphertext % prime_squared;
+    mpz_class exponent = prime - 1;
+    mpz_powm(u.get_mpz_t(), c.get_mpz_t(), exponent.get_mpz_t(), prime_squared.get_mpz_t());
+    mpz_class m = ((u - 1) / prime) * h;
+    mpz_mod(m.get_mpz_t(), m.get_mpz_t(), prime.get_mpz_t());
+    return m;
+}
+
+
+inline
+mpz_class PaillierKeyPair::decrypt(const mpz_class& ciphertext) const {
+    auto m_p = decryptModPrime(ciphertext, p_, p_squared_, h_p_);
+    auto m_q = decryptModPrime(ciphertext, q_, q_squared_, h_q_);
+
+    // m = m_q + q * ((m_p - m_q) * q^(-1) mod p)
+    mpz_class t = (m_p - m_q) * q_inv_p_;
+    mpz_mod(t.get_mpz_t(), t.get_mpz_t(), p_.get_mpz_t());
+    return m_q + q_ * t;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_PAILLIER_H
@@ -0,0 +1,166 @@
+#ifndef BIOAUTH_VECTOROLE_H
+#define BIOAUTH_VECTOROLE_H
+
+#include <array>
+#include <vector>
+#include <thread>
+#include <numeric>
+#include <algorithm>
+#include <execution>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "networking/Party.h"
+#include "utils/aes_ctr_prg.h"
+#include "ot-offline/OTExtension.h"
+
+namespace bioauth {
+
+// Gilboa's two-party product over Z_{2^l} from random OTs: the receiver holds a matrix X (dim_row x dim_mid),
+// the sender holds a matrix Y (dim_mid x dim_col), and afterwards the two outputs add up to X * Y.
+//
+// Each entry x of X is combined with the whole row y of Y it multiplies, by one OT per bit x_t of x:
+// the seeds (s_0, s_1) of the OT are expanded to vectors (M_0, M_1), the sender sends d = M_0 - M_1 + 2^t * y
+// and keeps -M_0, the receiver gets M_{x_t} + x_t * d = M_0 + x_t * 2^t * y.
+// Summed over the bits, the sender holds -sum(M_0) and the receiver sum(M_0) + x * y.
+//
+// The entries are processed in batches of about kBatchBytes of messages; the expansions of a batch run in parallel,
+// and the sender computes the next batch while the previous one is on the wire.
+
+namespace vector_ole_detail {
+
+constexpr std::size_t kBatchBytes = std::size_t{8} << 20;
+
+template <std::integral T>
+std::size_t batchSize(std::size_t num_bits, std::size_t dim_col) {
+    return std::max<std::size_t>(1, kBatchBytes / (num_bits * dim_col * sizeof(T)));
+}
+
+template <class Func>
+void parallelFor(std::size_t n, const Func& f) {
+    std::vector<std::size_t> indices(n);
+    std::iota(indices.begin(), indices.end(), std::size_t(0));
+#ifdef _LIBCPP_HAS_NO_INCOMPLETE_PSTL
+    std::for_each(indices.begin(), indices.end(), f);
+#else
+    std::for_each(std::execution::par, indices.begin(), indices.end(), f);
+#endif
+}
+
+template <std::integral T>
+void expand(OTBlock seed, T* out, std::size_t n) {
+    AesCtrPrg(ot_extension_detail::toSeed(seed)).fill(out, n * sizeof(T));
+}
+
+} // namespace vector_ole_detail
+
+
+/// The sender's side, returns its share of X * Y (dim_row x dim_col).
+/// Only the low num_bits bits of the entries of X are used.
+template <std::integral T>
+std::vector<T> gilboaSend(IknpSender& ot, Party& party, const std::vector<T>& y,
+                          std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col, std::size_t num_bits) {
+    using namespace vector_ole_detail;
+
+    std::vector<T> output(dim_row * dim_col);
+    const auto num_entries = dim_row * dim_mid;
+    const auto batch = batchSize<T>(num_bits, dim_col);
+
+    std::vector<T> to_send;
+    std::thread sending;
+    for (std::size_t first = 0; first < num_entries; first += batch) {
+        auto count = std::min(batch, num_entries - first);
+        auto seeds = ot.extend(count * num_bits);
+
+        std::vector<T> corrections(count * num_bits * dim_col);
+        std::vector<T> partial(count * dim_col);
+        parallelFor(count, [&](std::size_t e) {
+            const T* y_row = y.data() + ((first + e) % dim_mid) * dim_col;
+            T* u = partial.data() + e * dim_col;
+            std::vector<T> m1(dim_col);
+            for (std::size_t t = 0; t < num_bits; ++t) {
+                auto ot_idx = e * num_bits + t;
+                T* d = corrections.data() + ot_idx * dim_col;
+                expand(seeds[ot_idx][0], d, dim_col);
+                expand(seeds[ot_idx][1], m1.data(), dim_col);
+                for (std::size_t j = 0; j < dim_col; ++j) {
+                    u[j] -= d[j];
+                    d[j] = d[j] - m1[j] + (y_row[j] << t);
+                }
+            }
+        });
+
+        if (sending.joinable())
+            sending.join();
+        to_send = std::move(corrections);
+        sending = std::thread([&party, &to_send] { party.SendVecToOther(to_send); });
+
+        for (std::size_t e = 0; e < count; ++e) {
+            T* out_row = output.data() + ((first + e) / dim_mid) * dim_col;
+            const T* u = partial.data() + e * dim_col;
+            for (std::size_t j = 0; j < dim_col; ++j) {
+                out_row[j] += u[j];
+            }
+        }
+    }
+    if (sending.joinable())
+        sending.join();
+
+    return output;
+}
+
+
+/// The receiver's side, returns its share of X * Y (dim_row x dim_col).
+/// Only the low num_bits bits of the entries of X are used.
+template <std::integral T>
+std::vector<T> gilboaReceive(IknpReceiver& ot, Party& party, const std::vector<T>& x,
+                             std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col, std::size_t num_bits) {
+    using namespace vector_ole_detail;
+
+    std::vector<T> output(dim_row * dim_col);
+    const auto num_entries = dim_row * dim_mid;
+    const auto batch = batchSize<T>(num_bits, dim_col);
+
+    for (std::size_t first = 0; first < num_entries; first += batch) {
+        auto count = std::min(batch, num_entries - first);
+
+        std::vector<bool> choices(count * num_bits);
+        for (std::size_t e = 0; e < count; ++e) {
+            for (std::size_t t = 0; t < num_bits; ++t) {
+                choices[e * num_bits + t] = (x[first + e] >> t) & 1;
+            }
+        }
+        auto seeds = ot.extend(choices);
+        auto corrections = party.ReceiveVecFromOther<T>(count * num_bits * dim_col);
+
+        std::vector<T> partial(count * dim_col);
+        parallelFor(count, [&](std::size_t e) {
+            T* v = partial.data() + e * dim_col;
+            std::vector<T> m(dim_col);
+            for (std::size_t t = 0; t < num_bits; ++t) {
+                auto ot_idx = e * num_bits + t;
+                const T* d = corrections.data() + ot_idx * dim_col;
+                expand(seeds[ot_idx], m.data(), dim_col);
+                const T bit = (x[first + e] >> t) & 1;
+                for (std::size_t j = 0; j < dim_col; ++j) {
+                    v[j] += m[j] + bit * d[j];
+                }
+            }
+        });
+
+        for (std::size_t e = 0; e < count; ++e) {
+            T* out_row = output.data() + ((first + e) / dim_mid) * dim_col;
+            const T* v = partial.data() + e * dim_col;
+            for (std::size_t j = 0; j < dim_col; ++j) {
+                out_row[j] += v[j];
+            }
+        }
+    }
+
+    return output;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_VECTOROLE_H
@@ -21,6 +21,8 @@ public:
     AddConstantGate(const std::shared_ptr<Gate<ShrType>>& p_input_x,
                     const ClearType& constant);
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kLocal; }
+
 private:
     void doReadOfflineFromFile() override;
     void doRunOnline() override;
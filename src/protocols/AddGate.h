@@ -18,6 +18,8 @@ public:
     AddGate(const std::shared_ptr<Gate<ShrType>>& p_input_x,
             const std::shared_ptr<Gate<ShrType>>& p_input_y);
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kLocal; }
+
 private:
     void doReadOfflineFromFile() override;
     void doRunOnline() override;
@@ -0,0 +1,103 @@
+#ifndef BIOAUTH_AUTHBITS_H
+#define BIOAUTH_AUTHBITS_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace bioauth {
+
+// Bit-sliced XOR shares of two parties, authenticated with MACs as in TinyOT (https://ia.cr/2011/091).
+//
+// Party i holds share words x_i (bit l of a word belongs to the l-th of 64 sliced bits), and for each of them
+// kBitMacBits MAC words, while the other party j holds as many key words with
+//     mac[r] = key[r] ^ (Delta_j[r] ? x_i : 0),
+// where Delta_j is the kBitMacBits-bit binary MAC key of party j.
+// So each bit has a kBitMacBits-bit MAC, and opening a wrong share passes the check with probability 2^-kBitMacBits.
+//
+// XOR and AND with public words act on the shares, the MACs and the keys alike;
+// XOR with a public word flips the share of party 0 and the keys of party 1.
+
+constexpr std::size_t kBitMacBits = 40;
+
+/// Delta_masks[r] is all ones if bit r of the binary MAC key is set, zero otherwise
+using BitMacKeyMasks = std::array<uint64_t, kBitMacBits>;
+
+inline
+BitMacKeyMasks bitMacKeyMasks(uint64_t delta) {
+    BitMacKeyMasks masks;
+    for (std::size_t r = 0; r < kBitMacBits; ++r) {
+        masks[r] = ~((delta >> r) & 1) + 1;
+    }
+    return masks;
+}
+
+
+/// Authenticated bit-sliced shares, see above
+struct AuthBits {
+    std::vector<uint64_t> shares;
+    std::vector<uint64_t> macs; // kBitMacBits words per share word
+    std::vector<uint64_t> keys; // kBitMacBits words per share word of the other party
+
+    AuthBits() = default;
+
+    explicit AuthBits(std::size_t num_words)
+        : shares(num_words), macs(num_words * kBitMacBits), keys(num_words * kBitMacBits) {}
+
+    [[nodiscard]] std::size_t size() const { return shares.size(); }
+
+    [[nodiscard]] uint64_t* mac(std::size_t w) { return macs.data() + w * kBitMacBits; }
+    [[nodiscard]] const uint64_t* mac(std::size_t w) const { return macs.data() + w * kBitMacBits; }
+    [[nodiscard]] uint64_t* key(std::size_t w) { return keys.data() + w * kBitMacBits; }
+    [[nodiscard]] const uint64_t* key(std::size_t w) const { return keys.data() + w * kBitMacBits; }
+
+    /// Word w ^= word other_w of other
+    void xorWord(std::size_t w, const AuthBits& other, std::size_t other_w) {
+        shares[w] ^= other.shares[other_w];
+        for (std::size_t r = 0; r < kBitMacBits; ++r) {
+            mac(w)[r] ^= other.mac(other_w)[r];
+            key(w)[r] ^= other.key(other_w)[r];
+        }
+    }
+
+    /// Word w ^= constant, which both parties know
+    void xorPublic(std::size_t w, uint64_t constant, bool is_first, const BitMacKeyMasks& delta) {
+        if (is_first) {
+            shares[w] ^= constant;
+        } else {
+            for (std::size_t r = 0; r < kBitMacBits; ++r) {
+                key(w)[r] ^= constant & delta[r];
+            }
+        }
+    }
+
+    /// Word w &= constant, which both parties know
+    void andPublic(std::size_t w, uint64_t constant) {
+        shares[w] &= constant;
+        for (std::size_t r = 0; r < kBitMacBits; ++r) {
+            mac(w)[r] &= constant;
+            key(w)[r] &= constant;
+        }
+    }
+
+    /// Copies word other_w of other to word w
+    void copyWord(std::size_t w, const AuthBits& other, std::size_t other_w) {
+        shares[w] = other.shares[other_w];
+        for (std::size_t r = 0; r < kBitMacBits; ++r) {
+            mac(w)[r] = other.mac(other_w)[r];
+            key(w)[r] = other.key(other_w)[r];
+        }
+    }
+
+    /// Keeps the first num_words words
+    void resize(std::size_t num_words) {
+        shares.resize(num_words);
+        macs.resize(num_words * kBitMacBits);
+        keys.resize(num_words * kBitMacBits);
+    }
+};
+
+} // namespace bioauth
+
+#endif //BIOAUTH_AUTHBITS_H
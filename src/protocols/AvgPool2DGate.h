@@ -25,13 +25,18 @@ public:
     AvgPool2DGate(const std::shared_ptr<Gate<ShrType>>& p_input_x,
                   const MaxPoolOp& op);
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kOpening; }
+    [[nodiscard]] std::size_t openingReceiveSize() const override { return maxPoolOp.compute_output_size(); }
+
 private:
     void doReadOfflineFromFile() override;
-    void doRunOnline() override;
+    std::vector<SemiShrType> doPrepareOpening() override;
+    void doFinishOpening(std::vector<SemiShrType>&& received) override;
 
     MaxPoolOp maxPoolOp;
     ClearType factor; // equals 1 / kernel_size
     std::vector<SemiShrType> lambdaPreTruncShr, lambdaPreTruncShrMac;
+    std::vector<SemiShrType> delta_zShr;
 };
 
 template <IsSpdz2kShare ShrType>
@@ -55,7 +60,7 @@ void AvgPool2DGate<ShrType>::doReadOfflineFromFile() {
 }
 
 template <IsSpdz2kShare ShrType>
-void AvgPool2DGate<ShrType>::doRunOnline() {
+std::vector<typename AvgPool2DGate<ShrType>::SemiShrType> AvgPool2DGate<ShrType>::doPrepareOpening() {
     const auto& delta_x_clear = this->input_x()->Delta_clear();
     const auto& lambda_x_shr = this->input_x()->lambda_shr();
 
@@ -71,7 +76,7 @@ void AvgPool2DGate<ShrType>::doRunOnline() {
 
     auto size = maxPoolOp.compute_output_size();
 
-    auto delta_zShr = sumPool(x_shr, maxPoolOp);
+    delta_zShr = sumPool(x_shr, maxPoolOp);
     matrixScalarAssign(delta_zShr, static_cast<SemiShrType>(factor));
 
     assert(delta_zShr.size() == size);
@@ -79,18 +84,17 @@ void AvgPool2DGate<ShrType>::doRunOnline() {
     //truncation (needs communication)
     matrixAddAssign(delta_zShr, lambdaPreTruncShr);
 
-    std::vector<SemiShrType> delta_zRcv(size);
-    std::thread t1([this, &delta_zShr] {
-        this->party().SendVecToOther(delta_zShr);
-    });
-    std::thread t2([this, &delta_zRcv, size] {
-        delta_zRcv = this->party().template ReceiveVecFromOther<SemiShrType>(size);
-    });
-    t1.join();
-    t2.join();
-
-    this->Delta_clear() = matrixAdd(delta_zShr, delta_zRcv);
+    return delta_zShr;
+}
+
+template <IsSpdz2kShare ShrType>
+void AvgPool2DGate<ShrType>::doFinishOpening(std::vector<SemiShrType>&& received) {
+    this->Delta_clear() = std::move(received);
+    matrixAddAssign(this->Delta_clear(), delta_zShr);
     truncateClearVecInplace(this->Delta_clear());
+
+    delta_zShr.clear();
+    delta_zShr.shrink_to_fit();
 }
 
 } // namespace bioauth
@@ -6,15 +6,22 @@
 
 #include <memory>
 #include <vector>
+#include <thread>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "utils/Timer.h"
 #include "share/IsSpdz2kShare.h"
 #include "protocols/PartyWithFakeOffline.h"
 #include "protocols/Gate.h"
+#include "protocols/PreprocessingStream.h"
 #include "protocols/InputGate.h"
 #include "protocols/AddGate.h"
 #include "protocols/SubtractGate.h"
 #include "protocols/AddConstantGate.h"
+#include "protocols/ConstantGate.h"
+#include "protocols/GatherGate.h"
 #include "protocols/MultiplyGate.h"
 #include "protocols/OutputGate.h"
 #include "protocols/MultiplyTruncGate.h"
@@ -31,12 +38,16 @@ template <IsSpdz2kShare ShrType>
 class Circuit {
 public:
     using ClearType = typename ShrType::ClearType;
+    using GateType = Gate<ShrType>;
 
     explicit Circuit(PartyWithFakeOffline<ShrType>& party) : party_(party) {}
 
     void addEndpoint(const std::shared_ptr<Gate<ShrType>>& gate);
     void runOffline();
     void readOfflineFromFile();
+    /// Instead of reading all preprocessing data up front, read them on a background thread during runOnline,
+    /// keeping about `window` gates' data in memory
+    void streamOfflineFromFile(std::size_t window = kDefaultStreamWindow);
     void runOnline();
     void runOnlineWithBenckmark();
     void printStats();
@@ -53,6 +64,14 @@ public:
     std::shared_ptr<AddConstantGate<ShrType>>
     addConstant(const std::shared_ptr<Gate<ShrType>>& input_x, ClearType constant);
 
+    /// Public values, known to both parties when the circuit is built
+    std::shared_ptr<ConstantGate<ShrType>>
+    constant(std::size_t dim_row, std::size_t dim_col, const std::vector<ClearType>& values);
+
+    /// Entry i of the output is entry indices[i] of input_x
+    std::shared_ptr<GatherGate<ShrType>>
+    gather(const std::shared_ptr<Gate<ShrType>>& input_x, const std::vector<std::size_t>& indices);
+
     std::shared_ptr<MultiplyGate<ShrType>>
     multiply(const std::shared_ptr<Gate<ShrType>>& input_x, const std::shared_ptr<Gate<ShrType>>& input_y);
 
@@ -86,10 +105,24 @@ public:
 
     Timer& timer() { return timer_; }
 
+    static constexpr std::size_t kDefaultStreamWindow = 4;
+
 private:
+    using SemiShrType = typename ShrType::SemiShrType;
+
+    // Gates reachable from the endpoints for which skip() is false, inputs before outputs.
+    // This is also the order of the preprocessing data in the files.
+    template <class Skip>
+    std::vector<std::shared_ptr<Gate<ShrType>>> postOrder(Skip skip);
+
+    // Gates not yet evaluated online, inputs before outputs
+    std::vector<std::shared_ptr<Gate<ShrType>>> topologicalOrder();
+    void runOpenings(const std::vector<std::shared_ptr<Gate<ShrType>>>& openings);
+
     PartyWithFakeOffline<ShrType>& party_;
     std::vector<std::shared_ptr<Gate<ShrType>>> gates_;
     std::vector<std::shared_ptr<Gate<ShrType>>> endpoints_;
+    std::unique_ptr<PreprocessingStream<ShrType>> preprocessing_stream_; // only while streaming
     Timer timer_;
 };
 
@@ -115,11 +148,127 @@ void Circuit<ShrType>::readOfflineFromFile() {
     }
 }
 
+template <IsSpdz2kShare ShrType>
+void Circuit<ShrType>::streamOfflineFromFile(std::size_t window) {
+    auto order = postOrder([](const Gate<ShrType>& gate) { return gate.read_offline(); });
+    preprocessing_stream_ = std::make_unique<PreprocessingStream<ShrType>>(std::move(order), window);
+}
+
+template <IsSpdz2kShare ShrType>
+std::vector<std::shared_ptr<Gate<ShrType>>> Circuit<ShrType>::topologicalOrder() {
+    return postOrder([](const Gate<ShrType>& gate) { return gate.evaluated_online(); });
+}
+
+template <IsSpdz2kShare ShrType>
+template <class Skip>
+std::vector<std::shared_ptr<Gate<ShrType>>> Circuit<ShrType>::postOrder(Skip skip) {
+    std::vector<std::shared_ptr<Gate<ShrType>>> order;
+    std::unordered_set<Gate<ShrType>*> visited;
+
+    // Iterative post-order DFS, deep chains of gates should not overflow the stack
+    std::vector<std::pair<std::shared_ptr<Gate<ShrType>>, bool>> stack;
+    for (const auto& endpoint : endpoints_) {
+        stack.emplace_back(endpoint, false);
+    }
+    std::reverse(stack.begin(), stack.end());
+
+    while (!stack.empty()) {
+        auto [gate, expanded] = stack.back();
+        stack.pop_back();
+        if (!gate || skip(*gate))
+            continue;
+        if (expanded) {
+            order.push_back(gate);
+            continue;
+        }
+        if (!visited.insert(gate.get()).second)
+            continue;
+        stack.emplace_back(gate, true);
+        stack.emplace_back(gate->input_y(), false);
+        stack.emplace_back(gate->input_x(), false);
+    }
+    return order;
+}
+
+template <IsSpdz2kShare ShrType>
+void Circuit<ShrType>::runOpenings(const std::vector<std::shared_ptr<Gate<ShrType>>>& openings) {
+    // Coalesce the openings of the whole round into one message per direction.
+    // Both parties build the same circuit, so they agree on the order and the sizes.
+    std::vector<SemiShrType> to_send;
+    std::size_t receive_size = 0;
+    for (const auto& gate : openings) {
+        auto shares = gate->prepareOpening();
+        to_send.insert(to_send.end(), shares.begin(), shares.end());
+        receive_size += gate->openingReceiveSize();
+    }
+
+    std::vector<SemiShrType> received;
+    std::thread t1([this, &to_send] {
+        if (!to_send.empty())
+            party_.SendVecToOther(to_send);
+    });
+    if (receive_size != 0)
+        received = party_.template ReceiveVecFromOther<SemiShrType>(receive_size);
+    t1.join();
+
+    auto it = received.begin();
+    for (const auto& gate : openings) {
+        auto size = static_cast<std::ptrdiff_t>(gate->openingReceiveSize());
+        gate->finishOpening(std::vector<SemiShrType>(it, it + size));
+        it += size;
+    }
+}
+
 template <IsSpdz2kShare ShrType>
 void Circuit<ShrType>::runOnline() {
-    for (const auto& gate : endpoints_) {
-        gate->RunOnline();
+    auto order = topologicalOrder();
+
+    // A gate is ready in the round after all its communicating inputs have finished.
+    // Local gates finish in the round they are ready.
+    std::unordered_map<Gate<ShrType>*, std::size_t> round_of;
+    std::size_t num_rounds = 0;
+    for (const auto& gate : order) {
+        std::size_t round = 0;
+        for (const auto& input : {gate->input_x(), gate->input_y()}) {
+            auto it = input ? round_of.find(input.get()) : round_of.end();
+            if (it == round_of.end())
+                continue;
+            auto done = it->second + (input->onlineKind() == OnlineKind::kLocal ? 0 : 1);
+            round = std::max(round, done);
+        }
+        round_of[gate.get()] = round;
+        num_rounds = std::max(num_rounds, round + 1);
+    }
+
+    std::vector<std::vector<std::shared_ptr<Gate<ShrType>>>> rounds(num_rounds);
+    for (const auto& gate : order) {
+        rounds[round_of[gate.get()]].push_back(gate);
+    }
+
+    for (const auto& round : rounds) {
+        std::vector<std::shared_ptr<Gate<ShrType>>> openings;
+        for (const auto& gate : round) {
+            if (preprocessing_stream_)
+                preprocessing_stream_->waitFor(gate.get());
+            if (gate->onlineKind() == OnlineKind::kOpening)
+                openings.push_back(gate);
+            else
+                gate->RunOnline(); // local and interactive gates, in topological order
+        }
+        if (!openings.empty())
+            runOpenings(openings);
+        if (party_.mac_checker().due())
+            party_.CheckMacs();
+
+        if (preprocessing_stream_) {
+            for (const auto& gate : round)
+                preprocessing_stream_->release(gate.get());
+        }
     }
+    preprocessing_stream_.reset();
+
+    // The values opened since the last check
+    party_.CheckMacs();
 }
 
 template <IsSpdz2kShare ShrType>
@@ -170,6 +319,22 @@ addConstant(const std::shared_ptr<Gate<ShrType>>& input_x,
     return gate;
 }
 
+template <IsSpdz2kShare ShrType>
+std::shared_ptr<ConstantGate<ShrType>> Circuit<ShrType>::
+constant(std::size_t dim_row, std::size_t dim_col, const std::vector<ClearType>& values) {
+    auto gate = std::make_shared<ConstantGate<ShrType>>(party_, dim_row, dim_col, values);
+    gates_.push_back(gate);
+    return gate;
+}
+
+template <IsSpdz2kShare ShrType>
+std::shared_ptr<GatherGate<ShrType>> Circuit<ShrType>::
+gather(const std::shared_ptr<Gate<ShrType>>& input_x, const std::vector<std::size_t>& indices) {
+    auto gate = std::make_shared<GatherGate<ShrType>>(input_x, indices);
+    gates_.push_back(gate);
+    return gate;
+}
+
 template <IsSpdz2kShare ShrType>
 std::shared_ptr<MultiplyGate<ShrType>> Circuit<ShrType>::
 multiply(const std::shared_ptr<Gate<ShrType>>& input_x,
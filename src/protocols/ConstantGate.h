@@ -0,0 +1,57 @@
+#ifndef BIOAUTH_CONSTANTGATE_H
+#define BIOAUTH_CONSTANTGATE_H
+
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include "protocols/Gate.h"
+#include "share/IsSpdz2kShare.h"
+
+namespace bioauth {
+
+/// A matrix of public values, e.g., the indices of the entries of another matrix.
+/// Its lambda is 0, so Delta is the value itself and there is no preprocessing data.
+template <IsSpdz2kShare ShrType>
+class ConstantGate : public Gate<ShrType> {
+public:
+    using ClearType = typename ShrType::ClearType;
+    using SemiShrType = typename ShrType::SemiShrType;
+
+    ConstantGate(PartyWithFakeOffline<ShrType>& p_party, std::size_t p_dim_row, std::size_t p_dim_col,
+                 const std::vector<ClearType>& values);
+
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kLocal; }
+
+private:
+    void doReadOfflineFromFile() override;
+    void doRunOnline() override;
+
+    std::vector<ClearType> values_;
+};
+
+template <IsSpdz2kShare ShrType>
+ConstantGate<ShrType>::
+ConstantGate(PartyWithFakeOffline<ShrType>& p_party, std::size_t p_dim_row, std::size_t p_dim_col,
+             const std::vector<ClearType>& values)
+    : Gate<ShrType>(p_party, p_dim_row, p_dim_col), values_(values) {
+    if (values.size() != p_dim_row * p_dim_col) {
+        throw std::invalid_argument("The number of constants should match the dimensions");
+    }
+}
+
+template <IsSpdz2kShare ShrType>
+void ConstantGate<ShrType>::doReadOfflineFromFile() {
+    auto size = this->dim_row() * this->dim_col();
+    this->lambda_shr().assign(size, 0);
+    this->lambda_shr_mac().assign(size, 0);
+}
+
+template <IsSpdz2kShare ShrType>
+void ConstantGate<ShrType>::doRunOnline() {
+    this->Delta_clear().assign(values_.begin(), values_.end());
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_CONSTANTGATE_H
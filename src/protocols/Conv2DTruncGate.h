@@ -26,7 +26,7 @@ public:
 
 protected:
     void doReadOfflineFromFile() override;
-    void doRunOnline() override;
+    void doFinishOpening(std::vector<SemiShrType>&& received) override;
 
 private:
     std::vector<SemiShrType> lambda_prime_shr_;
@@ -56,8 +56,8 @@ void Conv2DTruncGate<ShrType>::doReadOfflineFromFile() {
 }
 
 template <IsSpdz2kShare ShrType>
-void Conv2DTruncGate<ShrType>::doRunOnline() {
-    Conv2DGate<ShrType>::doRunOnline();
+void Conv2DTruncGate<ShrType>::doFinishOpening(std::vector<SemiShrType>&& received) {
+    Conv2DGate<ShrType>::doFinishOpening(std::move(received));
 
     // The swap is done after the computation of the multiplication,
     // because the real prime values are used in the protocol.
@@ -20,9 +20,13 @@ public:
     ElemMultiplyGate(const std::shared_ptr<Gate<ShrType>>& p_input_x,
                      const std::shared_ptr<Gate<ShrType>>& p_input_y);
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kOpening; }
+    [[nodiscard]] std::size_t openingReceiveSize() const override { return this->dim_row() * this->dim_col(); }
+
 protected:
     void doReadOfflineFromFile() override;
-    void doRunOnline() override;
+    std::vector<SemiShrType> doPrepareOpening() override;
+    void doFinishOpening(std::vector<SemiShrType>&& received) override;
 
 private:
     std::vector<SemiShrType> a_shr_, a_shr_mac_;
@@ -30,6 +34,10 @@ private:
     std::vector<SemiShrType> c_shr_, c_shr_mac_;
     std::vector<SemiShrType> delta_x_clear_;
     std::vector<SemiShrType> delta_y_clear_;
+
+    // This party's shares of [Delta_z] and of its MAC, kept between prepare and finish
+    std::vector<SemiShrType> Delta_z_shr_;
+    std::vector<SemiShrType> Delta_z_mac_;
 };
 
 template <IsSpdz2kShare ShrType>
@@ -63,7 +71,7 @@ void ElemMultiplyGate<ShrType>::doReadOfflineFromFile() {
 }
 
 template <IsSpdz2kShare ShrType>
-void ElemMultiplyGate<ShrType>::doRunOnline() {
+std::vector<typename ElemMultiplyGate<ShrType>::SemiShrType> ElemMultiplyGate<ShrType>::doPrepareOpening() {
     // temp_x = $\Delta_x + \delta_x$
     auto temp_x = matrixAdd(this->input_x()->Delta_clear(), delta_x_clear_);
     // temp_y = $\Delta_y + \delta_y$
@@ -99,25 +107,27 @@ void ElemMultiplyGate<ShrType>::doRunOnline() {
     matrixSubtractAssign(Delta_z_mac,
                          matrixElemMultiply(temp_x, b_shr_mac_));
 
-    std::thread t1([&, this] {
-        this->party().SendVecToOther(Delta_z_shr);
-    });
-
-    std::thread t2([&, this] {
-        this->Delta_clear() = this->party().template ReceiveVecFromOther<
-            SemiShrType>(this->dim_row() * this->dim_col());
-    });
-
-    t1.join();
-    t2.join();
+    Delta_z_shr_ = Delta_z_shr;
+    Delta_z_mac_ = std::move(Delta_z_mac);
+    return Delta_z_shr;
+}
 
-    matrixAddAssign(this->Delta_clear(), Delta_z_shr);
+template <IsSpdz2kShare ShrType>
+void ElemMultiplyGate<ShrType>::doFinishOpening(std::vector<SemiShrType>&& received) {
+    // Delta_z = [Delta_z]_0 + [Delta_z]_1
+    this->Delta_clear() = std::move(received);
+    matrixAddAssign(this->Delta_clear(), Delta_z_shr_);
+    this->party().mac_checker().accumulate(this->Delta_clear(), Delta_z_mac_);
 
     // Since Delta_clear is in ClearType but stored in SemiShrType, we need to remove the upper bits
     // This is important since it affects the correctness in MultiplyTruncGate!!!
     ShrType::RemoveUpperBitsInplace(this->Delta_clear());
 
     // free the spaces of preprocessing data
+    Delta_z_shr_.clear();
+    Delta_z_shr_.shrink_to_fit();
+    Delta_z_mac_.clear();
+    Delta_z_mac_.shrink_to_fit();
     a_shr_.clear();
     a_shr_.shrink_to_fit();
     a_shr_mac_.clear();
@@ -5,6 +5,8 @@
 
 #include <vector>
 #include <memory>
+#include <thread>
+#include <stdexcept>
 
 #include "networking/Party.h"
 #include "share/IsSpdz2kShare.h"
@@ -14,6 +16,15 @@
 namespace bioauth {
 
 
+// How a gate interacts with the other party during the online phase.
+// The circuit scheduler uses it to batch the openings of independent gates into one round.
+enum class OnlineKind {
+    kLocal,       // no communication at all
+    kOpening,     // exactly one exchange, split into prepareOpening / finishOpening
+    kInteractive  // arbitrary communication, run on its own through RunOnline
+};
+
+
 template <IsSpdz2kShare ShrType>
 class Gate {
 public:
@@ -28,8 +39,21 @@ public:
 
     void RunOffline();
     void readOfflineFromFile();
+    // Read only this gate's data, the inputs' data must have been read before (used by PreprocessingStream)
+    void readOwnOfflineFromFile();
     void RunOnline();
 
+    // Split online evaluation of an opening gate, driven by the circuit scheduler.
+    // prepareOpening returns the values to be sent; finishOpening consumes the values received.
+    std::vector<SemiShrType> prepareOpening() { return doPrepareOpening(); }
+    void finishOpening(std::vector<SemiShrType>&& received);
+
+    [[nodiscard]] virtual OnlineKind onlineKind() const { return OnlineKind::kInteractive; }
+    [[nodiscard]] virtual std::size_t openingReceiveSize() const { return 0; }
+
+    [[nodiscard]] bool evaluated_online() const { return evaluated_online_; }
+    [[nodiscard]] bool read_offline() const { return read_offline_; }
+
     [[nodiscard]] auto& party() { return party_; }
 
     [[nodiscard]] std::size_t my_id() const { return party_.my_id(); }
@@ -56,7 +80,14 @@ protected:
 private:
     virtual void doRunOffline() { throw std::runtime_error("Offline Phase is not implemented."); }
     virtual void doReadOfflineFromFile() = 0;
-    virtual void doRunOnline() = 0;
+    // By default a gate is evaluated as a single opening, gates of other kinds override it
+    virtual void doRunOnline();
+    virtual std::vector<SemiShrType> doPrepareOpening() {
+        throw std::logic_error("The gate does not support split opening.");
+    }
+    virtual void doFinishOpening(std::vector<SemiShrType>&&) {
+        throw std::logic_error("The gate does not support split opening.");
+    }
 
     bool evaluated_offline_ = false;
     bool evaluated_online_ = false;
@@ -125,6 +156,17 @@ void Gate<ShrType>::readOfflineFromFile() {
 }
 
 
+template <IsSpdz2kShare ShrType>
+void Gate<ShrType>::readOwnOfflineFromFile() {
+    if (this->read_offline_)
+        return;
+
+    this->doReadOfflineFromFile();
+
+    this->read_offline_ = true;
+}
+
+
 template <IsSpdz2kShare ShrType>
 void Gate<ShrType>::RunOnline() {
     if (this->evaluated_online_)
@@ -140,6 +182,31 @@ void Gate<ShrType>::RunOnline() {
     this->evaluated_online_ = true;
 }
 
+
+template <IsSpdz2kShare ShrType>
+void Gate<ShrType>::finishOpening(std::vector<SemiShrType>&& received) {
+    this->doFinishOpening(std::move(received));
+    this->evaluated_online_ = true;
+}
+
+
+template <IsSpdz2kShare ShrType>
+void Gate<ShrType>::doRunOnline() {
+    auto to_send = this->doPrepareOpening();
+    std::vector<SemiShrType> received;
+
+    std::thread t1([this, &to_send] {
+        if (!to_send.empty())
+            this->party().SendVecToOther(to_send);
+    });
+    auto size = this->openingReceiveSize();
+    if (size != 0)
+        received = this->party().template ReceiveVecFromOther<SemiShrType>(size);
+    t1.join();
+
+    this->doFinishOpening(std::move(received));
+}
+
 }
 
 
@@ -0,0 +1,56 @@
+#ifndef BIOAUTH_GATHERGATE_H
+#define BIOAUTH_GATHERGATE_H
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "protocols/Gate.h"
+#include "share/IsSpdz2kShare.h"
+#include "utils/linear_algebra.h"
+
+namespace bioauth {
+
+/// Picks entries of the input: entry i of the output (a row vector) is entry indices[i] of the input.
+/// Lambda and Delta are picked alike, so it is local and has no preprocessing data.
+template <IsSpdz2kShare ShrType>
+class GatherGate : public Gate<ShrType> {
+public:
+    GatherGate(const std::shared_ptr<Gate<ShrType>>& p_input_x, const std::vector<std::size_t>& indices);
+
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kLocal; }
+
+private:
+    void doReadOfflineFromFile() override;
+    void doRunOnline() override;
+
+    std::vector<std::size_t> indices_;
+};
+
+template <IsSpdz2kShare ShrType>
+GatherGate<ShrType>::
+GatherGate(const std::shared_ptr<Gate<ShrType>>& p_input_x, const std::vector<std::size_t>& indices)
+    : Gate<ShrType>(p_input_x, nullptr), indices_(indices) {
+    auto size = p_input_x->dim_row() * p_input_x->dim_col();
+    if (std::ranges::any_of(indices, [size](std::size_t i) { return i >= size; })) {
+        throw std::out_of_range("The indices of the gather gate should be less than the size of its input");
+    }
+    this->set_dim_row(1);
+    this->set_dim_col(indices.size());
+}
+
+template <IsSpdz2kShare ShrType>
+void GatherGate<ShrType>::doReadOfflineFromFile() {
+    this->lambda_shr() = gatherVector(this->input_x()->lambda_shr(), indices_);
+    this->lambda_shr_mac() = gatherVector(this->input_x()->lambda_shr_mac(), indices_);
+}
+
+template <IsSpdz2kShare ShrType>
+void GatherGate<ShrType>::doRunOnline() {
+    this->Delta_clear() = gatherVector(this->input_x()->Delta_clear(), indices_);
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_GATHERGATE_H
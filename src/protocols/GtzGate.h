@@ -5,12 +5,16 @@
 
 #include <memory>
 #include <vector>
-#include <bitset>
 #include <thread>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
 #include "protocols/Gate.h"
 #include "share/IsSpdz2kShare.h"
 #include "utils/linear_algebra.h"
+#include "utils/bit_slice.h"
+#include "protocols/AuthBits.h"
 
 
 namespace bioauth {
@@ -24,31 +28,34 @@ public:
     explicit GtzGate(const std::shared_ptr<Gate<ShrType>>& p_input_x);
 
 private:
+    static constexpr std::size_t kNumBits = sizeof(ClearType) * 8;
+    // The carry tree reduces kNumBits - 1 planes to one, each pair of planes it combines takes two triples
+    static constexpr std::size_t kNumPairs = kNumBits - 2;
+
     void doReadOfflineFromFile() override;
 
     void doRunOnline() override;
 
-    // template <typename T>
-    // bool CarryOutAux(std::bitset<sizeof(T) * 8> p,
-    //                  std::bitset<sizeof(T) * 8> g, int k);
+    // Shares of [x >= 0] for x = Delta_x - lambda_x, bit-sliced (bit i of word w belongs to element 64 * w + i)
+    AuthBits GreaterEqualZero(const std::vector<ClearType>& delta_x);
 
-    std::vector<bool> BitLT(std::vector<ClearType>& pInt, // output s = (pInt < sInt)
-                            std::vector<ClearType>& sInt);
+    // Shares of the carry out of the bit-sliced (p, g) of num_bits planes,
+    // one layer of (p2,g2)*(p1,g1) = (p2p1,g2+p2g1) per round
+    AuthBits CarryOut(AuthBits p, AuthBits g, std::size_t num_bits, std::size_t num_words);
 
-    std::vector<bool> CarryOutCin(std::vector<std::bitset<sizeof(ClearType) * 8>>& aIn,
-                                  std::vector<std::bitset<sizeof(ClearType) * 8>>& bIn,
-                                  bool cIn); // a<-delta_x, b<-lambda_xBinShr
+    // Opens the first num_bytes bytes of the share words, returns the other party's words.
+    // The MACs go to the party's BitMacChecker.
+    std::vector<uint64_t> OpenBits(const AuthBits& bits, std::size_t num_bytes);
 
-    std::vector<bool> CarryOutAux(std::vector<std::bitset<sizeof(ClearType) * 8>> p,
-                                  std::vector<std::bitset<sizeof(ClearType) * 8>> g,
-                                  int k); // k bits, (p2,g2)*(p1,g1) = (p2p1,g2+p2g1)
+    AuthBits ReadAuthBits(std::size_t num_words);
 
     std::vector<ClearType> lambda_xBinShr;
 
-    // Binary Triples, we currently fake them as (0, 0, 0)
-    bool a = false;
-    bool b = false;
-    bool c = false;
+    // Binary MAC key of this gate, the boolean shares of lambda_x with their MACs,
+    // and the binary triples (a_p, b, a_p & b), (a_g, b, a_g & b) of each pair of planes in the carry tree
+    BitMacKeyMasks delta_;
+    AuthBits lambda_x_bits_;
+    AuthBits a_p_, a_g_, b_, c_p_, c_g_;
 };
 
 
@@ -60,381 +67,221 @@ GtzGate(const std::shared_ptr<Gate<ShrType>>& p_input_x)
     this->set_dim_col(p_input_x->dim_col());
 }
 
+template <IsSpdz2kShare ShrType>
+AuthBits GtzGate<ShrType>::ReadAuthBits(std::size_t num_words) {
+    AuthBits bits;
+    bits.shares = this->party().ReadBits(num_words);
+    bits.macs = this->party().ReadBits(num_words * kBitMacBits);
+    bits.keys = this->party().ReadBits(num_words * kBitMacBits);
+    return bits;
+}
+
 template <IsSpdz2kShare ShrType>
 void GtzGate<ShrType>::doReadOfflineFromFile() {
     auto size = this->dim_row() * this->dim_col();
+    auto num_words = numBitSliceWords(size);
 
     this->lambda_shr() = this->party().ReadShares(size);
     this->lambda_shr_mac() = this->party().ReadShares(size);
     lambda_xBinShr = this->party().ReadClear(size);
+
+    delta_ = bitMacKeyMasks(this->party().ReadBits(1).front());
+    lambda_x_bits_.shares = bitSlice<ClearType>(lambda_xBinShr, kNumBits);
+    lambda_x_bits_.macs = this->party().ReadBits(kNumBits * num_words * kBitMacBits);
+    lambda_x_bits_.keys = this->party().ReadBits(kNumBits * num_words * kBitMacBits);
+
+    for (auto* triple : {&a_p_, &a_g_, &b_, &c_p_, &c_g_}) {
+        *triple = ReadAuthBits(kNumPairs * num_words);
+    }
 }
 
 template <IsSpdz2kShare ShrType>
 void GtzGate<ShrType>::doRunOnline() {
-#ifndef NDEBUG
-    //        std::cout << "\nGtzGate Online\n";
-    //        std::cout << "lambdaShr:";
-    //        printVector(this->lambdaShr);
-    //        std::cout << "deltaClear:";
-    //        printVector(this->deltaClear);
-    //        std::cout << "lambda_xBinShr:";
-    //        printVector(this->lambda_xBinShr);
-#endif
-
-    // const auto& delta_x_semiShr = this->input_x->getDeltaClear();
-    const auto& delta_x_semiShr = this->input_x()->Delta_clear(); // By ybs
-
+    const auto& delta_x_semiShr = this->input_x()->Delta_clear();
     std::vector<ClearType> delta_x(delta_x_semiShr.begin(), delta_x_semiShr.end());
-    auto ret = BitLT(delta_x, this->lambda_xBinShr);
-    if (this->my_id() == 0) {
-        std::transform(ret.begin(), ret.end(), ret.begin(), std::logical_not<>());
-    }
+    auto size = delta_x.size();
 
-#ifndef NDEBUG
-    //        std::cout << "delta_x: ";
-    //        printVector(delta_x);
-    //        std::cout << "Lambda_xBinShr: ";
-    //        printVector(this->lambda_xBinShr);
-    //        std::cout << "Ret value of BitLT:";
-    //        printVector(ret);
-#endif
+    auto ret = GreaterEqualZero(delta_x);
 
     //TODO: this is fake
-
-    int msgBytes = (ret.size() + 7) / 8; // round up
-    //        std::vector<std::bitset<sizeof(uint8_t) * 8>> sendmsg(msgBytes, 0);
-    //        std::vector<std::bitset<sizeof(uint8_t) * 8>> rcvmsg(msgBytes, 0);
-
-    std::vector<uint8_t> sendmsg(msgBytes, 0);
-    // std::vector<uint8_t> rcvmsg(msgBytes, 0);
-    std::vector<uint8_t> rcvmsg; // By ybs
-    int vec_loc, bit_loc;
-    for (int j = 0; j < ret.size(); ++j) {
-        vec_loc = j / 8;
-        bit_loc = j % 8;
-        sendmsg[vec_loc] += ret[j] << bit_loc; //[p1] -[a]
-    }
 #ifndef NDEBUG
-    std::cout << "GtzGate open ret value, size: " << sendmsg.size() << "\n";
+    std::cout << "GtzGate open ret value, size: " << (size + 7) / 8 << "\n";
 #endif
-    // std::thread t1([this, &sendmsg]() { this->getParty()->getNetwork().send(1 - this->myId(), sendmsg); });
-    // std::thread t2(
-    //     [this, &rcvmsg] { this->getParty()->getNetwork().rcv(1 - this->myId(), &rcvmsg, rcvmsg.size()); });
-    std::thread t1([this, &sendmsg] { this->party().SendVecToOther(sendmsg); }); // By ybs
-    std::thread t2(
-        [this, &rcvmsg, msgBytes] {
-            rcvmsg = this->party().template ReceiveVecFromOther<uint8_t>(msgBytes);
-        }); // By ybs
-    t1.join();
-    t2.join();
-
-    std::vector<bool> rcv(ret.size());
-    for (int j = 0; j < rcv.size(); ++j) {
-        vec_loc = j / 8;
-        bit_loc = j % 8;
-        rcv[j] = std::bitset<sizeof(uint8_t) * 8>(rcvmsg[vec_loc])[bit_loc]; //[p1] -[a]
-    }
-
-
-    std::vector<SemiShrType> zShr(ret.size(), 0);
+    auto rcv = OpenBits(ret, (size + 7) / 8);
 
+    std::vector<SemiShrType> zShr(size, 0);
     if (this->my_id() == 0) {
-        std::transform(ret.begin(), ret.end(), rcv.begin(), zShr.begin(), std::bit_xor<>());
+        for (std::size_t i = 0; i < size; ++i) {
+            zShr[i] = ((ret.shares[i / 64] ^ rcv[i / 64]) >> (i % 64)) & 1;
+        }
     }
 
-    // this->deltaClear = matrixAdd(this->lambdaShr, zShr);
-    this->Delta_clear() = matrixAdd(this->lambda_shr(), zShr); // By ybs
-    std::vector<SemiShrType> deltaRcv(zShr.size());
+    this->Delta_clear() = matrixAdd(this->lambda_shr(), zShr);
+    std::vector<SemiShrType> deltaRcv(size);
 
 #ifndef NDEBUG
-    // std::cout << "GtzGate open deltaClear, size: " << this->deltaClear.size() << "\n";
     std::cout << "GtzGate open deltaClear, size: " << this->Delta_clear().size() << "\n";
 #endif
-    // std::thread t3([this]() { this->getParty()->getNetwork().send(1 - this->myId(), this->deltaClear); });
-    // std::thread t4([this, &deltaRcv]() {
-    //     this->getParty()->getNetwork().rcv(1 - this->myId(), &deltaRcv, deltaRcv.size());
-    // });
-
-    // By ybs begin
-    auto size = zShr.size();
     std::thread t3([this] { this->party().SendVecToOther(this->Delta_clear()); });
     std::thread t4(
         [this, &deltaRcv, size] {
             deltaRcv = this->party().template ReceiveVecFromOther<SemiShrType>(size);
         });
-    // By ybs end
-
     t3.join();
     t4.join();
 
-    // matrixAddAssign(this->deltaClear, deltaRcv);
-    matrixAddAssign(this->Delta_clear(), deltaRcv); // By ybs
+    matrixAddAssign(this->Delta_clear(), deltaRcv);
 }
 
 
-// template <IsSpdz2kShare ShrType>
-// template <typename T>
-// bool GtzGate<ShrType>::
-// CarryOutAux(std::bitset<sizeof(T) * 8> p, std::bitset<sizeof(T) * 8> g, int k) {
-//     //k bits, (p2,g2)*(p1,g1) = (p2p1,g2+p2g1)
-//     if (k > 1) {
-//         int u_len = k / 2; // round down bit length, if k%2=1, push back the last one bit at the end
-//         std::bitset<sizeof(T) * 8> u_p, u_g;
-//         // compute u[k/2..1] = (d[2k] * d[2k-1],...)---- compute p2*p1 and g2*p1 need 2 triples
-//         // (k/2)*2 triples per invocation
-//         int numTriples = u_len * 2; //parallel g.size() comparisons
-//         //prepare beaver's triples
-//         //[alpha] = [x] - [a]
-//         //[beta] = [y] - [b]
-//         // open alpha, beta
-//         // compute [z] = [c] + alpha*[b] + beta*[a] + alpha*beta
-//
-//         // each triple sholud send alpha, beta -- 2 bits
-//         int msgBytes = (numTriples * 2 + 7) / 8; // round up
-//         //            std::vector<std::bitset<sizeof(uint8_t)*8>> sendmsg(msgBytes,0);
-//         //            std::vector<std::bitset<sizeof(uint8_t)*8>> rcvmsg(msgBytes,0);
-//
-//         std::vector<uint8_t> sendmsg(msgBytes, 0);
-//         std::vector<uint8_t> rcvmsg(msgBytes, 0);
-//         int vec_loc, bit_loc;
-//         int index_triple = 0;
-//         // load the msg
-//         for (int j = 0; j < u_len; ++j) {
-//             vec_loc = index_triple * 2 / 8;
-//             bit_loc = (index_triple * 2) % 8;
-//             index_triple++;
-//             sendmsg[vec_loc] += (p[2 * j] ^ a) << bit_loc; //[p1] -[a]
-//             sendmsg[vec_loc] += (p[2 * j + 1] ^ b) << (bit_loc + 1); //[p2] -[b]
-//             vec_loc = index_triple * 2 / 8;
-//             bit_loc = (index_triple * 2) % 8;
-//             index_triple++;
-//             sendmsg[vec_loc] = (g[2 * j] ^ a) << bit_loc; //[g1] -[a]
-//             sendmsg[vec_loc] = (p[2 * j + 1] ^ b) << (bit_loc + 1); //[p2] -[b]
-//         }
-//         //send & rcv
-//         //send numTriples, sendmsg; receive numTriples rcvmsg
-//         std::thread t1([this, &sendmsg]() {
-//             this->party->getNetwork().send(1 - this->myId(), sendmsg);
-//         });
-//         std::thread t2([this, &rcvmsg]() {
-//             this->party->getNetwork().rcv(1 - this->myId(), &rcvmsg, rcvmsg.size());
-//         });
-//         t1.join();
-//         t2.join();
-//         //#ifndef NDEBUG
-//         //            std::cout<<"sendmsg: ";printVector(sendmsg);
-//         //            std::cout<<"rcvmsg: "; printVector(rcvmsg);
-//         //#endif
-//         //compute
-//         bool alpha, beta, z, x_, y_;
-//         index_triple = 0;
-//         for (int j = 0; j < u_len; ++j) {
-//             // compute u_p, u_g
-//             vec_loc = index_triple * 2 / 8;
-//             bit_loc = (index_triple * 2) % 8;
-//             index_triple++;
-//             alpha = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc] ^ std::bitset<sizeof(uint8_t) *
-//                 8>(rcvmsg[vec_loc])[bit_loc]; // alpha = p1 -a
-//             beta = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc + 1] ^ std::bitset<sizeof(uint8_t) *
-//                 8>(rcvmsg[vec_loc])[bit_loc + 1]; // beta = p2 - b
-//             x_ = p[2 * j], y_ = p[2 * j + 1]; //x_ -- p1, y_ -- p2
-//             z = c ^ (alpha & y_) ^ (beta & x_); // z = p1p2
-//             if (this->myId() == 0) z ^= (alpha & beta);
-//             u_p[j] = z;
-//             vec_loc = index_triple * 2 / 8;
-//             bit_loc = (index_triple * 2) % 8;
-//             index_triple++;
-//             alpha = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc] ^ std::bitset<sizeof(uint8_t) *
-//                 8>(rcvmsg[vec_loc])[bit_loc]; // open g1 -a
-//             beta = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc + 1] ^ std::bitset<sizeof(uint8_t) *
-//                 8>(rcvmsg[vec_loc])[bit_loc + 1]; // open  p2 -b
-//             x_ = g[2 * j], y_ = p[2 * j + 1]; // x_ -- g1 y_ -- p2
-//             z = c ^ (alpha & y_) ^ (beta & x_); // z = p2g1
-//             if (this->myId() == 0) z ^= (alpha & beta);
-//             u_g[j] = g[2 * j + 1] ^ z; // u_g = g2 + p2g1
-//         }
-//         if (index_triple < numTriples) std::cout << "triples amount error\n";
-//         if (k % 2 == 1) {
-//             u_len += 1;
-//             for (int i = 0; i < p.size(); ++i) {
-//                 u_p[i][u_len] = p[i][k - 1];
-//                 u_g[i][u_len] = g[i][k - 1];
-//             }
-//         }
-//         auto ret = CarryOutAux(u_p, u_g, u_len); // u_len : bit length
-//         return ret;
-//     }
-//     else {
-//         return g[0]; // Actcually only care g[..][0]
-//     }
-// }
-
-
 template <IsSpdz2kShare ShrType>
-std::vector<bool> GtzGate<ShrType>::
-BitLT(std::vector<ClearType>& pInt, std::vector<ClearType>& sInt) {
-    // output s = (pInt < sInt)
-    std::vector<std::bitset<sizeof(ClearType) * 8>> b_(sInt.size());
-    std::vector<std::bitset<sizeof(ClearType) * 8>> a_(pInt.size());
-    for (int i = 0; i < sInt.size(); ++i) {
-        if (this->my_id() == 0) b_[i] = ~sInt[i]; //b_[i][j] = 1 - b[i][j]
-        else b_[i] = sInt[i];
-        a_[i] = pInt[i];
-    }
-    auto s = CarryOutCin(a_, b_, 1);
-    for (int i = 0; i < s.size(); ++i) {
-        if (this->my_id() == 0) s[i] = 1 ^ s[i]; //s[i] = 1 -s[i]
+std::vector<uint64_t> GtzGate<ShrType>::OpenBits(const AuthBits& bits, std::size_t num_bytes) {
+    std::vector<uint8_t> sendmsg = planeToBytes(bits.shares, num_bytes * 8);
+    std::vector<uint8_t> rcvmsg;
+    std::thread t1([this, &sendmsg] { this->party().SendVecToOther(sendmsg); });
+    std::thread t2(
+        [this, &rcvmsg, num_bytes] {
+            rcvmsg = this->party().template ReceiveVecFromOther<uint8_t>(num_bytes);
+        });
+    t1.join();
+    t2.join();
+    auto rcv = bytesToPlane(rcvmsg);
+
+    // The MAC of the other party's word is key ^ (Delta & word)
+    std::vector<uint64_t> expected(bits.keys);
+    for (std::size_t w = 0; w < rcv.size(); ++w) {
+        for (std::size_t r = 0; r < kBitMacBits; ++r) {
+            expected[w * kBitMacBits + r] ^= delta_[r] & rcv[w];
+        }
     }
-    return s;
+    this->party().bit_mac_checker().accumulate(bits.macs, expected);
+    return rcv;
 }
 
 
 template <IsSpdz2kShare ShrType>
-std::vector<bool> GtzGate<ShrType>::
-CarryOutCin(std::vector<std::bitset<sizeof(ClearType) * 8>>& aIn,
-            std::vector<std::bitset<sizeof(ClearType) * 8>>& bIn,
-            bool cIn) {
-    //a<-delta_x, b<-lambda_xBinShr
-    std::vector<std::bitset<sizeof(ClearType) * 8>> p(bIn.size());
-    std::vector<std::bitset<sizeof(ClearType) * 8>> g(bIn.size());
-    //compute p[i] = a[i]^b[i], g[i] = a[i]*b[i]
-    int numBits = sizeof(ClearType) * 8;
-    for (int i = 0; i < bIn.size(); ++i) {
-        for (int j = 0; j < numBits; j++) {
-            if (this->my_id() == 0) p[i][j] = aIn[i][j] ^ bIn[i][j];
-            else p[i][j] = bIn[i][j]; //p = a+b -2ab
-            g[i][j] = aIn[i][j] & bIn[i][j]; //g = a*b
-        }
+AuthBits GtzGate<ShrType>::
+GreaterEqualZero(const std::vector<ClearType>& delta_x) {
+    // x < 0 iff its top bit is set, and with ' dropping the top bit,
+    // top(x) = top(Delta_x) ^ top(lambda_x) ^ [Delta_x' < lambda_x'].
+    // [Delta_x' >= lambda_x'] is the carry out of Delta_x' + ~lambda_x' + 1,
+    // so [x >= 0] = carry ^ top(Delta_x) ^ top(lambda_x).
+    const auto size = delta_x.size();
+    const auto num_words = numBitSliceWords(size);
+    const auto num_low_bits = kNumBits - 1;
+    const bool is_first = this->my_id() == 0;
+
+    auto delta_bits = bitSlice<ClearType>(delta_x, kNumBits);
+
+    // p = Delta_x ^ ~lambda_x, g = Delta_x & ~lambda_x, Delta_x is public
+    AuthBits p(num_low_bits * num_words);
+    AuthBits g(num_low_bits * num_words);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        p.copyWord(i, lambda_x_bits_, i);
+        p.xorPublic(i, ~uint64_t{0}, is_first, delta_);
+        g.copyWord(i, p, i);
+        g.andPublic(i, delta_bits[i]);
+        p.xorPublic(i, delta_bits[i], is_first, delta_);
+    }
+    // carry in c = 1: g1 = g1 + c*p1
+    for (std::size_t w = 0; w < num_words; ++w) {
+        g.xorWord(w, p, w);
     }
-    for (int i = 0; i < bIn.size(); ++i) {
-        g[i][0] = g[i][0] ^ (cIn & p[i][0]); // g1 = g1 + c*p1
+
+    auto ret = CarryOut(std::move(p), std::move(g), num_low_bits, num_words);
+    const auto top = num_low_bits * num_words;
+    for (std::size_t w = 0; w < num_words; ++w) {
+        ret.xorWord(w, lambda_x_bits_, top + w);
+        ret.xorPublic(w, delta_bits[top + w], is_first, delta_);
+        // The bits past the last element are not opened
+        auto num_valid = std::min<std::size_t>(64, size - 64 * w);
+        ret.andPublic(w, num_valid == 64 ? ~uint64_t{0} : (uint64_t{1} << num_valid) - 1);
     }
-    return CarryOutAux(p, g, numBits);
+    return ret;
 }
 
+
 template <IsSpdz2kShare ShrType>
-std::vector<bool> GtzGate<ShrType>::
-CarryOutAux(std::vector<std::bitset<sizeof(ClearType) * 8>> p,
-            std::vector<std::bitset<sizeof(ClearType) * 8>> g,
-            int k) {
-    //k bits, (p2,g2)*(p1,g1) = (p2p1,g2+p2g1)
-    if (k > 1) {
-        int u_len = k / 2; // round down bit length, if k%2=1, push back the last one bit at the end
-        std::vector<std::bitset<sizeof(ClearType) * 8>> u_p(p.size(), 0);
-        std::vector<std::bitset<sizeof(ClearType) * 8>> u_g(p.size(), 0);
-        // compute u[k/2..1] = (d[2k] * d[2k-1],...)---- compute p2*p1 and g2*p1 need 2 triples
-        // (k/2)*2 triples per invocation
-        int numTriples = g.size() * u_len * 2; //parallel g.size() comparisons
-        //prepare beaver's triples
-        //[alpha] = [x] - [a]
-        //[beta] = [y] - [b]
-        // open alpha, beta
-        // compute [z] = [c] + alpha*[b] + beta*[a] + alpha*beta
-
-        // each triple should send alpha, beta -- 2 bits
-        int msgBytes = (numTriples * 2 + 7) / 8; // round up
-        std::vector<uint8_t> sendmsg(msgBytes, 0);
-        std::vector<uint8_t> rcvmsg(msgBytes, 0);
-        std::vector<ClearType> sendMacmsg(numTriples * 2, 0);
-        std::vector<ClearType> rcvMacmsg(numTriples * 2, 0);
-        int vec_loc, bit_loc;
-        int index_triple = 0;
-        // load the msg
-        for (int i = 0; i < g.size(); ++i) {
-            // parallel comparison
-            for (int j = 0; j < u_len; ++j) {
-                vec_loc = index_triple * 2 / 8;
-                bit_loc = (index_triple * 2) % 8;
-                index_triple++;
-                sendmsg[vec_loc] += (p[i][2 * j] ^ a) << bit_loc; //[p1] -[a]
-                sendmsg[vec_loc] += (p[i][2 * j + 1] ^ b) << (bit_loc + 1); //[p2] -[b]
-                vec_loc = index_triple * 2 / 8;
-                bit_loc = (index_triple * 2) % 8;
-                index_triple++;
-                sendmsg[vec_loc] += (g[i][2 * j] ^ a) << bit_loc; //[g1] -[a]
-                sendmsg[vec_loc] += (p[i][2 * j + 1] ^ b) << (bit_loc + 1); //[p2] -[b]
+AuthBits GtzGate<ShrType>::
+CarryOut(AuthBits p, AuthBits g, std::size_t num_bits, std::size_t num_words) {
+    const bool is_first = this->my_id() == 0;
+    std::size_t first_pair = 0; // the triples of the previous layers are used
+
+    while (num_bits > 1) {
+        // Plane j of the next layer combines planes 2j (p1,g1) and 2j+1 (p2,g2), a trailing odd plane is kept.
+        // p2p1 and p2g1 take one Beaver triple each:
+        //   [alpha] = [x] - [a], [beta] = [y] - [b], open alpha, beta,
+        //   [z] = [c] + alpha*[y] + beta*[x] + alpha*beta,
+        // the two triples share b, so that p2 is opened once.
+        const auto half = num_bits / 2;
+        const auto layer = half * num_words;
+
+        // alpha of p2p1, alpha of p2g1, beta, plane after plane
+        AuthBits masked(3 * layer);
+        for (std::size_t j = 0; j < half; ++j) {
+            for (std::size_t w = 0; w < num_words; ++w) {
+                auto idx = j * num_words + w;
+                auto lo = 2 * j * num_words + w;
+                auto hi = lo + num_words;
+                auto triple = (first_pair + j) * num_words + w;
+                masked.copyWord(idx, p, lo);
+                masked.xorWord(idx, a_p_, triple);
+                masked.copyWord(layer + idx, g, lo);
+                masked.xorWord(layer + idx, a_g_, triple);
+                masked.copyWord(2 * layer + idx, p, hi);
+                masked.xorWord(2 * layer + idx, b_, triple);
             }
         }
-        //send & rcv
-        //send numTriples, sendmsg; receive numTriples rcvmsg
 #ifndef NDEBUG
-        std::cout << "GtzGate send p,g triples, size: " << sendmsg.size() << "\n";
+        std::cout << "GtzGate send p,g triples, size: " << masked.size() * sizeof(uint64_t) << "\n";
 #endif
-        // std::thread t1([this, &sendmsg,&sendMacmsg]() {
-        //     this->party->getNetwork().send(1 - this->myId(), sendmsg);
-        //     this->party->getNetwork().send(1 - this->myId(), sendMacmsg);
-        // });
-        // std::thread t2([this, &rcvmsg,&rcvMacmsg]() {
-        //     this->party->getNetwork().rcv(1 - this->myId(), &rcvmsg, rcvmsg.size());
-        //     this->party->getNetwork().rcv(1 - this->myId(), &rcvMacmsg, rcvMacmsg.size());
-        // });
-
-        std::thread t1([this, &sendmsg, &sendMacmsg] {
-            this->party().SendVecToOther(sendmsg);
-            this->party().SendVecToOther(sendMacmsg);
-        });
-        std::thread t2([this, &rcvmsg, &rcvMacmsg, msgBytes, numTriples] {
-            rcvmsg = this->party().template ReceiveVecFromOther<uint8_t>(msgBytes);
-            rcvMacmsg = this->party().template ReceiveVecFromOther<ClearType>(numTriples * 2);
-        });
+        auto opened = OpenBits(masked, masked.size() * sizeof(uint64_t));
+        for (std::size_t i = 0; i < opened.size(); ++i) {
+            opened[i] ^= masked.shares[i];
+        }
 
-        t1.join();
-        t2.join();
-
-        //#ifndef NDEBUG
-        //            std::cout<<"sendmsg: ";printVector(sendmsg);
-        //            std::cout<<"rcvmsg: "; printVector(rcvmsg);
-        //#endif
-        //compute
-        bool alpha, beta, z, x_, y_;
-        index_triple = 0;
-        for (int i = 0; i < g.size(); ++i) {
-            // parallel comparison
-            for (int j = 0; j < u_len; ++j) {
-                // compute u_p, u_g
-                vec_loc = index_triple * 2 / 8;
-                bit_loc = (index_triple * 2) % 8;
-                index_triple++;
-                alpha = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc] ^ std::bitset<sizeof(uint8_t) *
-                    8>(rcvmsg[vec_loc])[bit_loc]; // alpha = p1 -a
-                beta = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc + 1] ^ std::bitset<sizeof(uint8_t) *
-                    8>(rcvmsg[vec_loc])[bit_loc + 1]; // beta = p2 - b
-                x_ = p[i][2 * j], y_ = p[i][2 * j + 1]; //x_ -- p1, y_ -- p2
-                z = c ^ (alpha & y_) ^ (beta & x_); // z = p1p2
-                if (this->my_id() == 0) z ^= (alpha & beta);
-                u_p[i][j] = z;
-                vec_loc = index_triple * 2 / 8;
-                bit_loc = (index_triple * 2) % 8;
-                index_triple++;
-                alpha = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc] ^ std::bitset<sizeof(uint8_t) *
-                    8>(rcvmsg[vec_loc])[bit_loc]; // open p1 -a
-                beta = std::bitset<sizeof(uint8_t) * 8>(sendmsg[vec_loc])[bit_loc + 1] ^ std::bitset<sizeof(uint8_t) *
-                    8>(rcvmsg[vec_loc])[bit_loc + 1]; // open  p2 -b
-                x_ = g[i][2 * j], y_ = p[i][2 * j + 1]; // x_ -- g1 y_ -- p2
-                z = c ^ (alpha & y_) ^ (beta & x_); // z = p2g1
-                if (this->my_id() == 0) z ^= (alpha & beta);
-                u_g[i][j] = g[i][2 * j + 1] ^ z; // u_g = g2 + p2g1
+        const auto next_bits = (num_bits + 1) / 2;
+        AuthBits next_p(next_bits * num_words);
+        AuthBits next_g(next_bits * num_words);
+        // out = c ^ (alpha & y) ^ (beta & x) ^ (alpha & beta)
+        auto multiply = [&](AuthBits& out, std::size_t out_w, const AuthBits& c, std::size_t c_w,
+                            uint64_t alpha, const AuthBits& y, std::size_t y_w,
+                            uint64_t beta, const AuthBits& x, std::size_t x_w) {
+            out.shares[out_w] = c.shares[c_w] ^ (alpha & y.shares[y_w]) ^ (beta & x.shares[x_w]);
+            for (std::size_t r = 0; r < kBitMacBits; ++r) {
+                out.mac(out_w)[r] = c.mac(c_w)[r] ^ (alpha & y.mac(y_w)[r]) ^ (beta & x.mac(x_w)[r]);
+                out.key(out_w)[r] = c.key(c_w)[r] ^ (alpha & y.key(y_w)[r]) ^ (beta & x.key(x_w)[r]);
             }
-        }
-        if (index_triple < numTriples) std::cout << "triples amount error\n";
-        if (k % 2 == 1) {
-            u_len += 1;
-            for (int i = 0; i < p.size(); ++i) {
-                u_p[i][u_len] = p[i][k - 1];
-                u_g[i][u_len] = g[i][k - 1];
+            out.xorPublic(out_w, alpha & beta, is_first, delta_);
+        };
+        for (std::size_t j = 0; j < half; ++j) {
+            for (std::size_t w = 0; w < num_words; ++w) {
+                auto idx = j * num_words + w;
+                auto lo = 2 * j * num_words + w;
+                auto hi = lo + num_words;
+                auto triple = (first_pair + j) * num_words + w;
+                auto alpha_p = opened[idx];
+                auto alpha_g = opened[layer + idx];
+                auto beta = opened[2 * layer + idx];
+                multiply(next_p, idx, c_p_, triple, alpha_p, p, hi, beta, p, lo); // z = p1p2
+                multiply(next_g, idx, c_g_, triple, alpha_g, p, hi, beta, g, lo); // z = p2g1
+                next_g.xorWord(idx, g, hi); // u_g = g2 + p2g1
             }
         }
-        auto ret = CarryOutAux(u_p, u_g, u_len); // u_len : bit length
-        return ret;
-    }
-    else {
-        //k<=1
-        std::vector<bool> ret(g.size());
-        for (int i = 0; i < ret.size(); ++i) {
-            ret[i] = g[i][0];
+        if (num_bits % 2 == 1) {
+            for (std::size_t w = 0; w < num_words; ++w) {
+                next_p.copyWord(layer + w, p, (num_bits - 1) * num_words + w);
+                next_g.copyWord(layer + w, g, (num_bits - 1) * num_words + w);
+            }
         }
-        return ret; // Actually only care g[..][0]
+        p = std::move(next_p);
+        g = std::move(next_g);
+        first_pair += half;
+        num_bits = next_bits;
     }
+
+    g.resize(num_words); // Actually only care g[0]
+    return g;
 }
 
 } // namespace bioauth
@@ -23,9 +23,16 @@ public:
 
     void setInput(const std::vector<ClearType>& input_value);
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kOpening; }
+    // Only the party that does not own the input receives anything
+    [[nodiscard]] std::size_t openingReceiveSize() const override {
+        return this->my_id() == owner_id_ ? 0 : this->dim_row() * this->dim_col();
+    }
+
 private:
     void doReadOfflineFromFile() override;
-    void doRunOnline() override;
+    std::vector<SemiShrType> doPrepareOpening() override;
+    void doFinishOpening(std::vector<SemiShrType>&& received) override;
 
     std::size_t owner_id_;
     std::vector<SemiShrType> lambda_clear_;
@@ -66,14 +73,19 @@ void InputGate<ShrType>::doReadOfflineFromFile() {
 
 
 template <IsSpdz2kShare ShrType>
-void InputGate<ShrType>::doRunOnline() {
+std::vector<typename InputGate<ShrType>::SemiShrType> InputGate<ShrType>::doPrepareOpening() {
     if (this->my_id() == owner_id_) {
         this->Delta_clear() = matrixAdd(input_value_, this->lambda_clear_);
-        this->party().SendVecToOther(this->Delta_clear());
+        return this->Delta_clear();
     }
-    else {
-        auto size = this->dim_row() * this->dim_col();
-        this->Delta_clear() = this->party().template ReceiveVecFromOther<SemiShrType>(size);
+    return {};
+}
+
+
+template <IsSpdz2kShare ShrType>
+void InputGate<ShrType>::doFinishOpening(std::vector<SemiShrType>&& received) {
+    if (this->my_id() != owner_id_) {
+        this->Delta_clear() = std::move(received);
     }
 }
 
@@ -0,0 +1,271 @@
+#ifndef BIOAUTH_MACCHECK_H
+#define BIOAUTH_MACCHECK_H
+
+#include <array>
+#include <span>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#include "share/IsSpdz2kShare.h"
+#include "networking/Party.h"
+#include "utils/aes_ctr_prg.h"
+
+namespace bioauth {
+
+// The batched MAC check of SPDZ2k (https://ia.cr/2018/482), for two parties.
+//
+// The opened values x_j and this party's MAC shares m_j are kept until the check. Then
+//  1. the parties agree on a random seed by committing to their own seeds and opening them,
+//  2. each party expands the seed to coefficients r_j and computes y = sum r_j * x_j, m = sum r_j * m_j,
+//  3. each party commits to z = m - key_shr * y and opens it, and the check passes if the z add up to 0.
+// All in Z_{2^(k+s)}, with four exchanges of a few dozen bytes, however many values were opened.
+//
+// The binary values of the comparisons carry TinyOT MACs instead (see protocols/AuthBits.h), which are linear over GF(2).
+// There each party hashes the MACs of the shares it opened, and the MACs it expects for the shares it received,
+// so that a check is one exchange of the hashes.
+
+namespace mac_check_detail {
+
+using Digest = std::array<uint8_t, 32>;
+using Nonce = std::array<uint8_t, 16>;
+
+inline
+void randomBytes(uint8_t* out, std::size_t size) {
+    if (RAND_bytes(out, static_cast<int>(size)) != 1) {
+        throw std::runtime_error("Failed to generate random bytes for the MAC check");
+    }
+}
+
+/// SHA-256(data || nonce)
+inline
+Digest commit(std::span<const uint8_t> data, const Nonce& nonce) {
+    std::vector<uint8_t> input(data.begin(), data.end());
+    input.insert(input.end(), nonce.begin(), nonce.end());
+
+    Digest digest;
+    unsigned int size = 0;
+    if (EVP_Digest(input.data(), input.size(), digest.data(), &size, EVP_sha256(), nullptr) != 1) {
+        throw std::runtime_error("Failed to compute the commitment of the MAC check");
+    }
+    return digest;
+}
+
+/// Sends the bytes to the other party and receives as many bytes from it
+inline
+std::vector<uint8_t> exchangeBytes(Party& party, const std::vector<uint8_t>& to_send) {
+    std::thread t1([&party, &to_send] { party.SendVecToOther(to_send); });
+    auto received = party.ReceiveVecFromOther<uint8_t>(to_send.size());
+    t1.join();
+    return received;
+}
+
+/// Commits to the value, opens it after the other party committed, and returns the other party's value
+inline
+std::vector<uint8_t> commitAndOpen(Party& party, const std::vector<uint8_t>& value) {
+    Nonce nonce;
+    randomBytes(nonce.data(), nonce.size());
+    auto digest = commit(value, nonce);
+    auto other_digest = exchangeBytes(party, std::vector<uint8_t>(digest.begin(), digest.end()));
+
+    std::vector<uint8_t> opening(value);
+    opening.insert(opening.end(), nonce.begin(), nonce.end());
+    auto other_opening = exchangeBytes(party, opening);
+
+    std::vector<uint8_t> other_value(other_opening.begin(), other_opening.begin() + value.size());
+    Nonce other_nonce;
+    std::memcpy(other_nonce.data(), other_opening.data() + value.size(), other_nonce.size());
+    auto expected = commit(other_value, other_nonce);
+    if (!std::equal(expected.begin(), expected.end(), other_digest.begin())) {
+        throw std::runtime_error("MAC check failed: the other party opened a different value than it committed to");
+    }
+    return other_value;
+}
+
+} // namespace mac_check_detail
+
+
+/// Accumulates the opened values and their MAC shares, and checks them in one batch
+template <IsSpdz2kShare ShrType>
+class MacChecker {
+public:
+    using SemiShrType = typename ShrType::SemiShrType;
+    using GlobalKeyType = typename ShrType::GlobalKeyType;
+
+    /// Keep the values opened so far, opened[j] is the sum of all parties' shares (not reduced modulo 2^k)
+    void accumulate(std::span<const SemiShrType> opened, std::span<const SemiShrType> mac_shares);
+
+    /// Check all the values accumulated since the last check.
+    /// Throws std::runtime_error if the MACs do not match.
+    void check(Party& party, GlobalKeyType key_shr);
+
+    /// Whether the accumulated values reached the interval
+    [[nodiscard]] bool due() const { return interval_ != 0 && opened_.size() >= interval_; }
+
+    /// Check every `interval` opened values in addition to the end of the online phase, 0 means only at the end
+    void set_interval(std::size_t interval) { interval_ = interval; }
+
+    /// Values are not accumulated if disabled
+    void set_enabled(bool enabled) { enabled_ = enabled; }
+
+    [[nodiscard]] bool enabled() const { return enabled_; }
+    [[nodiscard]] std::size_t num_pending() const { return opened_.size(); }
+    [[nodiscard]] std::size_t num_checks() const { return num_checks_; }
+
+private:
+    bool enabled_ = true;
+    std::size_t interval_ = 0;
+    std::size_t num_checks_ = 0;
+    std::vector<SemiShrType> opened_;
+    std::vector<SemiShrType> mac_shares_;
+};
+
+
+template <IsSpdz2kShare ShrType>
+void MacChecker<ShrType>::accumulate(std::span<const SemiShrType> opened, std::span<const SemiShrType> mac_shares) {
+    if (!enabled_)
+        return;
+    if (opened.size() != mac_shares.size()) {
+        throw std::invalid_argument("Each opened value needs a MAC share");
+    }
+    opened_.insert(opened_.end(), opened.begin(), opened.end());
+    mac_shares_.insert(mac_shares_.end(), mac_shares.begin(), mac_shares.end());
+}
+
+
+template <IsSpdz2kShare ShrType>
+void MacChecker<ShrType>::check(Party& party, GlobalKeyType key_shr) {
+    using namespace mac_check_detail;
+
+    if (opened_.empty())
+        return;
+
+    // The coefficients must be unpredictable until all values are opened, so the seed is agreed on only now
+    std::vector<uint8_t> my_seed(sizeof(AesCtrPrg::Seed));
+    randomBytes(my_seed.data(), my_seed.size());
+    auto other_seed = commitAndOpen(party, my_seed);
+    AesCtrPrg::Seed seed;
+    for (std::size_t i = 0; i < seed.size(); ++i) {
+        seed[i] = my_seed[i] ^ other_seed[i];
+    }
+
+    AesCtrPrg prg(seed);
+    auto coefficients = prg.next<SemiShrType>(opened_.size());
+    SemiShrType y = 0;
+    SemiShrType m = 0;
+    for (std::size_t j = 0; j < opened_.size(); ++j) {
+        y += coefficients[j] * opened_[j];
+        m += coefficients[j] * mac_shares_[j];
+    }
+    SemiShrType z = m - static_cast<SemiShrType>(key_shr) * y;
+
+    std::vector<uint8_t> my_z(sizeof(SemiShrType));
+    std::memcpy(my_z.data(), &z, sizeof(z));
+    auto other_z_bytes = commitAndOpen(party, my_z);
+    SemiShrType other_z;
+    std::memcpy(&other_z, other_z_bytes.data(), sizeof(other_z));
+
+    // The MACs are in Z_{2^(k+s)}, SemiShrType may have more bits
+    constexpr auto kUnusedBits = 8 * sizeof(SemiShrType) - (ShrType::kBits + ShrType::sBits);
+    if (static_cast<SemiShrType>((z + other_z) << kUnusedBits) != 0) {
+        throw std::runtime_error("MAC check failed");
+    }
+
+    ++num_checks_;
+    opened_.clear();
+    mac_shares_.clear();
+}
+
+
+/// Accumulates the MACs of opened binary shares (see protocols/AuthBits.h), and checks them in one batch
+class BitMacChecker {
+public:
+    BitMacChecker() { reset(); }
+
+    /// my_macs are the MACs of the share words this party sent,
+    /// expected_macs are key ^ (Delta & received share) for the share words it received, in the same order
+    void accumulate(std::span<const uint64_t> my_macs, std::span<const uint64_t> expected_macs);
+
+    /// Check all the MACs accumulated since the last check.
+    /// Throws std::runtime_error if the other party opened a share with a wrong MAC.
+    void check(Party& party);
+
+    /// MACs are not accumulated if disabled
+    void set_enabled(bool enabled) { enabled_ = enabled; }
+
+    [[nodiscard]] bool enabled() const { return enabled_; }
+    [[nodiscard]] std::size_t num_pending() const { return num_pending_; }
+    [[nodiscard]] std::size_t num_checks() const { return num_checks_; }
+
+private:
+    using DigestContext = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>;
+
+    void reset();
+
+    bool enabled_ = true;
+    std::size_t num_pending_ = 0;
+    std::size_t num_checks_ = 0;
+    DigestContext my_macs_{nullptr, EVP_MD_CTX_free};
+    DigestContext expected_macs_{nullptr, EVP_MD_CTX_free};
+};
+
+
+inline
+void BitMacChecker::reset() {
+    for (auto* context : {&my_macs_, &expected_macs_}) {
+        context->reset(EVP_MD_CTX_new());
+        if (!*context || EVP_DigestInit_ex(context->get(), EVP_sha256(), nullptr) != 1) {
+            throw std::runtime_error("Failed to initialize the hash of the binary MAC check");
+        }
+    }
+    num_pending_ = 0;
+}
+
+
+inline
+void BitMacChecker::accumulate(std::span<const uint64_t> my_macs, std::span<const uint64_t> expected_macs) {
+    if (!enabled_)
+        return;
+    if (EVP_DigestUpdate(my_macs_.get(), my_macs.data(), my_macs.size_bytes()) != 1 ||
+        EVP_DigestUpdate(expected_macs_.get(), expected_macs.data(), expected_macs.size_bytes()) != 1) {
+        throw std::runtime_error("Failed to hash the MACs of the binary MAC check");
+    }
+    num_pending_ += expected_macs.size();
+}
+
+
+inline
+void BitMacChecker::check(Party& party) {
+    using namespace mac_check_detail;
+
+    if (num_pending_ == 0)
+        return;
+
+    std::vector<uint8_t> my_digest(32);
+    Digest expected;
+    unsigned int size = 0;
+    if (EVP_DigestFinal_ex(my_macs_.get(), my_digest.data(), &size) != 1 ||
+        EVP_DigestFinal_ex(expected_macs_.get(), expected.data(), &size) != 1) {
+        throw std::runtime_error("Failed to hash the MACs of the binary MAC check");
+    }
+
+    // The MACs only depend on the keys, which the other party knows anyway, so there is nothing to commit to
+    auto other_digest = exchangeBytes(party, my_digest);
+    reset();
+    if (!std::equal(expected.begin(), expected.end(), other_digest.begin())) {
+        throw std::runtime_error("Binary MAC check failed");
+    }
+    ++num_checks_;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_MACCHECK_H
@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <thread>
 #include <numeric>
+#include <span>
 
 #include "protocols/Gate.h"
 #include "share/IsSpdz2kShare.h"
@@ -25,18 +26,30 @@ public:
 
     [[nodiscard]] std::size_t dim_mid() const { return dim_mid_; }
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kOpening; }
+    [[nodiscard]] std::size_t openingReceiveSize() const override { return this->dim_row() * this->dim_col(); }
+
 protected:
     void doReadOfflineFromFile() override;
-    void doRunOnline() override;
+    std::vector<SemiShrType> doPrepareOpening() override;
+    void doFinishOpening(std::vector<SemiShrType>&& received) override;
 
 private:
     std::size_t dim_mid_;
 
+    // [a] and [b] are only read, so they are viewed in place in the preprocessing file when possible,
+    // the vectors only hold them otherwise
     std::vector<SemiShrType> a_shr_, a_shr_mac_;
     std::vector<SemiShrType> b_shr_, b_shr_mac_;
+    std::span<const SemiShrType> a_view_, a_mac_view_;
+    std::span<const SemiShrType> b_view_, b_mac_view_;
     std::vector<SemiShrType> c_shr_, c_shr_mac_;
     std::vector<SemiShrType> delta_x_clear_;
     std::vector<SemiShrType> delta_y_clear_;
+
+    // This party's shares of [Delta_z] and of its MAC, kept between prepare and finish
+    std::vector<SemiShrType> Delta_z_shr_;
+    std::vector<SemiShrType> Delta_z_mac_;
 };
 
 template <IsSpdz2kShare ShrType>
@@ -59,10 +72,10 @@ void MultiplyGate<ShrType>::doReadOfflineFromFile() {
     auto size_rhs = this->dim_mid() * this->dim_col();
     auto size_output = this->dim_row() * this->dim_col();
 
-    a_shr_ = this->party().ReadShares(size_lhs);
-    a_shr_mac_ = this->party().ReadShares(size_lhs);
-    b_shr_ = this->party().ReadShares(size_rhs);
-    b_shr_mac_ = this->party().ReadShares(size_rhs);
+    a_view_ = this->party().ReadSharesView(size_lhs, a_shr_);
+    a_mac_view_ = this->party().ReadSharesView(size_lhs, a_shr_mac_);
+    b_view_ = this->party().ReadSharesView(size_rhs, b_shr_);
+    b_mac_view_ = this->party().ReadSharesView(size_rhs, b_shr_mac_);
     c_shr_ = this->party().ReadShares(size_output);
     c_shr_mac_ = this->party().ReadShares(size_output);
     this->lambda_shr() = this->party().ReadShares(size_output);
@@ -72,91 +85,65 @@ void MultiplyGate<ShrType>::doReadOfflineFromFile() {
 }
 
 template <IsSpdz2kShare ShrType>
-void MultiplyGate<ShrType>::doRunOnline() {
+std::vector<typename MultiplyGate<ShrType>::SemiShrType> MultiplyGate<ShrType>::doPrepareOpening() {
+    // The preprocessing vectors are consumed here, so they are reused as the outputs instead of allocating
     // temp_x = $\Delta_x + \delta_x$
-    auto temp_x = matrixAdd(this->input_x()->Delta_clear(), delta_x_clear_);
+    auto temp_x = std::move(delta_x_clear_);
+    matrixAddAssign(temp_x, this->input_x()->Delta_clear());
     // temp_y = $\Delta_y + \delta_y$
-    //std::cout << "1: " << this->party().bytes_sent() << " bytes\n";
-    auto temp_y = matrixAdd(this->input_y()->Delta_clear(), delta_y_clear_);
+    auto temp_y = std::move(delta_y_clear_);
+    matrixAddAssign(temp_y, this->input_y()->Delta_clear());
+
+    // Compute [Delta_z] and [Delta_z_mac] according to the paper
+    // [Delta_z] = [c] + [lambda_z], [Delta_z_mac] = [c_mac] + [lambda_z_mac]
+    auto Delta_z_shr = std::move(c_shr_);
+    matrixAddAssign(Delta_z_shr, this->lambda_shr());
+    auto Delta_z_mac = std::move(c_shr_mac_);
+    matrixAddAssign(Delta_z_mac, this->lambda_shr_mac());
+
     // temp_xy = temp_x * temp_y
-    //std::cout << "2: " << this->party().bytes_sent() << " bytes\n";
-    auto temp_xy = matrixMultiply(temp_x, temp_y, this->dim_row(), this->dim_mid(), this->dim_col());
-    //std::cout << "3: " << this->party().bytes_sent() << " bytes\n";
-    
-    // Compute [Delta_z] according to the paper
-    // [Delta_z] = [c] + [lambda_z]
-    auto Delta_z_shr = matrixAdd(c_shr_, this->lambda_shr());
-    // [Delta_z] -= [a] * temp_y
-    matrixSubtractAssign(Delta_z_shr,
-                         matrixMultiply(a_shr_, temp_y, this->dim_row(), this->dim_mid(), this->dim_col()));
-    // [Delta_z] -= temp_x * [b]
-    matrixSubtractAssign(Delta_z_shr,
-                         matrixMultiply(temp_x, b_shr_, this->dim_row(), this->dim_mid(), this->dim_col()));
+    // [Delta_z] -= [a] * temp_y + temp_x * [b]
+    // [Delta_z_mac] -= [a_mac] * temp_y + temp_x * [b_mac]
+    // all in one pass over temp_y, [b] and [b_mac]
+    std::vector<SemiShrType> temp_xy(this->dim_row() * this->dim_col());
+    fusedBeaverGemm(temp_x.data(), temp_y.data(),
+                    a_view_.data(), a_mac_view_.data(),
+                    b_view_.data(), b_mac_view_.data(),
+                    temp_xy.data(), Delta_z_shr.data(), Delta_z_mac.data(),
+                    this->dim_row(), this->dim_mid(), this->dim_col());
+
     if (this->my_id() == 0) {
         // [Delta_z] += temp_xy
         matrixAddAssign(Delta_z_shr, temp_xy);
     }
-    
-    // Compute Delta_z_mac according to the paper结果验证
-    // [Delta_z_mac] = temp_xy * [key]
-    auto Delta_z_mac = std::move(temp_xy);
-    matrixScalarAssign(Delta_z_mac, this->party().global_key_shr());
-    // [Delta_z_mac] += [c_mac] + [lambda_z_mac]
-    matrixAddAssign(Delta_z_mac,
-                    matrixAdd(c_shr_mac_, this->lambda_shr_mac()));
-    // [Delta_z_mac] -= [a_mac] * temp_y
-    matrixSubtractAssign(Delta_z_mac,
-                         matrixMultiply(a_shr_mac_, temp_y, this->dim_row(), this->dim_mid(), this->dim_col()));
-    // [Delta_z_mac] -= temp_x * [b_mac]
-    matrixSubtractAssign(Delta_z_mac,
-                         matrixMultiply(temp_x, b_shr_mac_, this->dim_row(), this->dim_mid(), this->dim_col()));
-
-    using ClearType = typename ShrType::ClearType;
-    //ClearType inner_product_share = std::accumulate(Delta_z_shr.begin(), Delta_z_shr.end(), ClearType(0));
-    auto inner_product_shares = Delta_z_shr;  // 直接使用每个 [Δ_z]
-
-    //std::cout << "Before communication: " << this->party().bytes_sent() << " bytes\n";
-    uint64_t before_ = this->party().bytes_sent();
-    //std::cout << "Before communication: " << before_ << " bytes\n";
-    //std::cout << "size: " << inner_product_shares.size() << " \n";
-    std::thread t1([&, this]() {
-        //this->party().SendVecToOther(std::vector<ClearType>{inner_product_share});  
-        this->party().SendVecToOther(inner_product_shares);
-    });
-
-    //std::vector<ClearType> received_vec = this->party().template ReceiveVecFromOther<ClearType>(1);
-    std::vector<ClearType> received_vec = this->party().template ReceiveVecFromOther<ClearType>(inner_product_shares.size());
-    t1.join();
-    //uint64_t after_ = this->party().bytes_sent();
-    this->party().comm_actual_=this->party().bytes_sent()-before_;
-    //this->party().comm_after_ = this->party().bytes_sent();
-    //uint64_t bytes_sent_=bytes_sent_actual(comm_before,comm_after);
-
-   // std::cout << "After communication: " << this->party().comm_actual_<< " bytes\n";
-    //ClearType final_share = inner_product_share + received_vec[0];
-    std::vector<ClearType> added_clear(inner_product_shares.size());
-    for (std::size_t i = 0; i < inner_product_shares.size(); ++i) {
-        added_clear[i] = inner_product_shares[i] + received_vec[i];
-    }
+    // [Delta_z_mac] += temp_xy * [key]
+    matrixScalarAssign(temp_xy, this->party().global_key_shr());
+    matrixAddAssign(Delta_z_mac, temp_xy);
 
+    // Bytes this gate puts on the wire, reported by the experiments
+    this->party().comm_actual_ = Delta_z_shr.size() * sizeof(SemiShrType);
 
-    //this->Delta_clear().resize(1);
-    //this->Delta_clear()[0] = final_share;
+    Delta_z_shr_ = Delta_z_shr;
+    Delta_z_mac_ = std::move(Delta_z_mac);
+    return Delta_z_shr;
+}
 
+template <IsSpdz2kShare ShrType>
+void MultiplyGate<ShrType>::doFinishOpening(std::vector<SemiShrType>&& received) {
+    // Delta_z = [Delta_z]_0 + [Delta_z]_1
+    this->Delta_clear() = std::move(received);
+    matrixAddAssign(this->Delta_clear(), Delta_z_shr_);
+    this->party().mac_checker().accumulate(this->Delta_clear(), Delta_z_mac_);
 
     // Since Delta_clear is in ClearType but stored in SemiShrType, we need to remove the upper bits
     // This is important since it affects the correctness in MultiplyTruncGate!!!
-    //ShrType::RemoveUpperBitsInplace(this->Delta_clear());
-
-    std::vector<SemiShrType> final_shares;
-    final_shares.reserve(added_clear.size());
-    for (const auto& val : added_clear) {
-         final_shares.emplace_back(static_cast<SemiShrType>(val));  // 转换 ClearType → SemiShrType
-    }
-    this->Delta_clear() = std::move(final_shares);
     ShrType::RemoveUpperBitsInplace(this->Delta_clear());
 
     // free the spaces of preprocessing data
+    Delta_z_shr_.clear();
+    Delta_z_shr_.shrink_to_fit();
+    Delta_z_mac_.clear();
+    Delta_z_mac_.shrink_to_fit();
     a_shr_.clear();
     a_shr_.shrink_to_fit();
     a_shr_mac_.clear();
@@ -165,6 +152,7 @@ void MultiplyGate<ShrType>::doRunOnline() {
     b_shr_.shrink_to_fit();
     b_shr_mac_.clear();
     b_shr_mac_.shrink_to_fit();
+    a_view_ = a_mac_view_ = b_view_ = b_mac_view_ = {};
     c_shr_.clear();
     c_shr_.shrink_to_fit();
     c_shr_mac_.clear();
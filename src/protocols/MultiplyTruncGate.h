@@ -26,7 +26,7 @@ public:
 
 protected:
     void doReadOfflineFromFile() override;
-    void doRunOnline() override;
+    void doFinishOpening(std::vector<SemiShrType>&& received) override;
 
 private:
     std::vector<SemiShrType> lambda_prime_shr_;
@@ -60,8 +60,8 @@ void MultiplyTruncGate<ShrType>::doReadOfflineFromFile() {
 
 
 template <IsSpdz2kShare ShrType>
-void MultiplyTruncGate<ShrType>::doRunOnline() {
-    MultiplyGate<ShrType>::doRunOnline();
+void MultiplyTruncGate<ShrType>::doFinishOpening(std::vector<SemiShrType>&& received) {
+    MultiplyGate<ShrType>::doFinishOpening(std::move(received));
 
     // The swap is done after the computation of the multiplication,
     // because the real prime values are used in the protocol.
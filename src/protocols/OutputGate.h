@@ -24,9 +24,13 @@ public:
 
     std::vector<ClearType> getClear() const;
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kOpening; }
+    [[nodiscard]] std::size_t openingReceiveSize() const override { return this->dim_row() * this->dim_col(); }
+
 private:
     void doReadOfflineFromFile() override;
-    void doRunOnline() override;
+    std::vector<SemiShrType> doPrepareOpening() override;
+    void doFinishOpening(std::vector<SemiShrType>&& received) override;
 
     std::vector<SemiShrType> lambda_clear_;
     std::vector<SemiShrType> output_value_;
@@ -46,24 +50,16 @@ void OutputGate<ShrType>::doReadOfflineFromFile() {} // Do nothing
 
 
 template <IsSpdz2kShare ShrType>
-void OutputGate<ShrType>::doRunOnline() {
-    auto size = this->dim_row() * this->dim_col();
-
-    // std::cerr << "Delta_clear:" << '\n';
-    // PrintVector(this->input_x()->Delta_clear());
-
-    std::thread t1([this] {
-        this->party().SendVecToOther(this->input_x()->lambda_shr());
-    });
-
-    std::thread t2([this, size] {
-        this->lambda_clear_ = this->party().template ReceiveVecFromOther<SemiShrType>(size);
-    });
+std::vector<typename OutputGate<ShrType>::SemiShrType> OutputGate<ShrType>::doPrepareOpening() {
+    return this->input_x()->lambda_shr();
+}
 
-    t1.join();
-    t2.join();
 
+template <IsSpdz2kShare ShrType>
+void OutputGate<ShrType>::doFinishOpening(std::vector<SemiShrType>&& received) {
+    lambda_clear_ = std::move(received);
     matrixAddAssign(lambda_clear_, this->input_x()->lambda_shr()); // reconstruct $\lambda_x$
+    this->party().mac_checker().accumulate(lambda_clear_, this->input_x()->lambda_shr_mac());
     output_value_ = matrixSubtract(this->input_x()->Delta_clear(), lambda_clear_); // $x = \Delta_x - \lambda_x$
 }
 
@@ -6,10 +6,14 @@
 #include <string>
 #include <fstream>
 #include <filesystem>
+#include <memory>
+#include <span>
 
 #include "share/IsSpdz2kShare.h"
 #include "networking/Party.h"
 #include "utils/uint128_io.h"
+#include "utils/preprocessing_file.h"
+#include "protocols/MacCheck.h"
 
 namespace bioauth{
 
@@ -21,21 +25,48 @@ public:
     using GlobalKeyType = typename ShrType::GlobalKeyType;
     using SemiShrType = typename ShrType::SemiShrType;
 
+    /// Reads "<job_name>-party-<id>.bin" written by FakeParty,
+    /// or the text file "<job_name>-party-<id>.txt" of older runs if there is no binary file.
     PartyWithFakeOffline(std::size_t p_my_id, std::size_t p_num_parties, std::size_t p_port,
                          const std::string& job_name);
 
     std::vector<SemiShrType> ReadShares(std::size_t num_elements);
 
+    /// Read shares that are only read afterwards.
+    /// Returns a view into the mapped binary file if possible,
+    /// otherwise the shares are read into `storage` and the returned view refers to it.
+    std::span<const SemiShrType> ReadSharesView(std::size_t num_elements, std::vector<SemiShrType>& storage);
+
     std::vector<ClearType> ReadClear(std::size_t num_elements);
 
+    /// Read words of bit-sliced binary shares, MACs or keys (see protocols/AuthBits.h)
+    std::vector<uint64_t> ReadBits(std::size_t num_words);
+
     [[nodiscard]] std::ifstream& input_file() { return input_file_; }
 
+    [[nodiscard]] bool has_binary_input() const { return binary_input_ != nullptr; }
+
     [[nodiscard]] GlobalKeyType global_key_shr() const { return global_key_shr_; }
 
+    /// The gates hand their opened values and MAC shares to it, see protocols/MacCheck.h
+    [[nodiscard]] MacChecker<ShrType>& mac_checker() { return mac_checker_; }
+
+    /// The comparison gates hand the MACs of their opened binary shares to it
+    [[nodiscard]] BitMacChecker& bit_mac_checker() { return bit_mac_checker_; }
+
+    /// Check the MACs of the values opened since the last check, throws std::runtime_error if they do not match
+    void CheckMacs() {
+        mac_checker_.check(*this, global_key_shr_);
+        bit_mac_checker_.check(*this);
+    }
+
 private:
     inline static const std::filesystem::path kFakeOfflineDir{FAKE_OFFLINE_DIR}; // The macro is in CMakeLists.txt
     GlobalKeyType global_key_shr_;
-    std::ifstream input_file_;
+    std::unique_ptr<PreprocessingReader> binary_input_;
+    std::ifstream input_file_; // only used for text files
+    MacChecker<ShrType> mac_checker_;
+    BitMacChecker bit_mac_checker_;
 };
 
 
@@ -43,9 +74,19 @@ template <IsSpdz2kShare ShrType>
 PartyWithFakeOffline<ShrType>::
 PartyWithFakeOffline(std::size_t p_my_id, std::size_t p_num_parties, std::size_t p_port, const std::string& job_name)
     : Party(p_my_id, p_num_parties, p_port) {
-    // Open the file for input
-    std::string file_name = job_name + (job_name.empty() ? "party-" : "-party-") + std::to_string(p_my_id) + ".txt";
-    input_file_.open(kFakeOfflineDir / file_name);
+    // Open the file for input, preferring the binary format
+    std::string file_name = job_name + (job_name.empty() ? "party-" : "-party-") + std::to_string(p_my_id);
+    auto binary_path = kFakeOfflineDir / (file_name + ".bin");
+    if (exists(binary_path)) {
+        binary_input_ = std::make_unique<PreprocessingReader>(binary_path);
+        global_key_shr_ = binary_input_->read<GlobalKeyType>(1).front();
+        return;
+    }
+
+    input_file_.open(kFakeOfflineDir / (file_name + ".txt"));
+    if (!input_file_) {
+        throw std::runtime_error("No preprocessing file for " + file_name + " in " + kFakeOfflineDir.string());
+    }
 
     // Read the MAC key
     input_file_ >> global_key_shr_;
@@ -55,6 +96,10 @@ PartyWithFakeOffline(std::size_t p_my_id, std::size_t p_num_parties, std::size_t
 template <IsSpdz2kShare ShrType>
 std::vector<typename PartyWithFakeOffline<ShrType>::SemiShrType> PartyWithFakeOffline<ShrType>::
 ReadShares(std::size_t num_elements) {
+    if (binary_input_) {
+        return binary_input_->read<SemiShrType>(num_elements);
+    }
+
     auto shares = std::vector<SemiShrType>(num_elements);
     for (auto& share : shares) {
         input_file_ >> share;
@@ -62,9 +107,23 @@ ReadShares(std::size_t num_elements) {
     return shares;
 }
 
+template <IsSpdz2kShare ShrType>
+std::span<const typename PartyWithFakeOffline<ShrType>::SemiShrType> PartyWithFakeOffline<ShrType>::
+ReadSharesView(std::size_t num_elements, std::vector<SemiShrType>& storage) {
+    if (binary_input_ && binary_input_->canView<SemiShrType>(num_elements)) {
+        return binary_input_->view<SemiShrType>(num_elements);
+    }
+    storage = ReadShares(num_elements);
+    return storage;
+}
+
 template <IsSpdz2kShare ShrType>
 std::vector<typename PartyWithFakeOffline<ShrType>::ClearType> PartyWithFakeOffline<ShrType>::
 ReadClear(std::size_t num_elements) {
+    if (binary_input_) {
+        return binary_input_->read<ClearType>(num_elements);
+    }
+
     auto clear = std::vector<ClearType>(num_elements);
     for (auto& c : clear) {
         input_file_ >> c;
@@ -72,6 +131,20 @@ ReadClear(std::size_t num_elements) {
     return clear;
 }
 
+template <IsSpdz2kShare ShrType>
+std::vector<uint64_t> PartyWithFakeOffline<ShrType>::
+ReadBits(std::size_t num_words) {
+    if (binary_input_) {
+        return binary_input_->read<uint64_t>(num_words);
+    }
+
+    auto words = std::vector<uint64_t>(num_words);
+    for (auto& word : words) {
+        input_file_ >> word;
+    }
+    return words;
+}
+
 } // namespace bioauth
 
 
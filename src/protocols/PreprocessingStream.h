@@ -0,0 +1,147 @@
+#ifndef BIOAUTH_PREPROCESSINGSTREAM_H
+#define BIOAUTH_PREPROCESSINGSTREAM_H
+
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+
+#include "share/IsSpdz2kShare.h"
+#include "protocols/Gate.h"
+
+namespace bioauth {
+
+/// Reads the preprocessing data of the gates on a background thread while the online phase runs.
+///
+/// The gates must be given in the order their data are stored in the file.
+/// At most `window` gates are read but not yet released, unless the online phase waits for a gate further ahead
+/// (the online phase does not necessarily evaluate the gates in file order), then it reads up to that gate.
+template <IsSpdz2kShare ShrType>
+class PreprocessingStream {
+public:
+    PreprocessingStream(std::vector<std::shared_ptr<Gate<ShrType>>> gates, std::size_t window);
+
+    PreprocessingStream(const PreprocessingStream&) = delete;
+    PreprocessingStream& operator=(const PreprocessingStream&) = delete;
+
+    ~PreprocessingStream();
+
+    /// Block until the gate's data are read, rethrows the exception if reading failed
+    void waitFor(const Gate<ShrType>* gate);
+
+    /// The gate was evaluated online, so it no longer counts towards the window
+    void release(const Gate<ShrType>* gate);
+
+private:
+    void run();
+
+    std::vector<std::shared_ptr<Gate<ShrType>>> gates_;
+    std::unordered_map<const Gate<ShrType>*, std::size_t> position_;
+    std::size_t window_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::size_t num_read_ = 0;
+    std::size_t num_in_window_ = 0;
+    std::size_t num_wanted_ = 0; // the online phase waits for the first num_wanted_ gates
+    std::vector<bool> released_;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    std::thread thread_; // last, so that it starts after the other members are initialized
+};
+
+
+template <IsSpdz2kShare ShrType>
+PreprocessingStream<ShrType>::
+PreprocessingStream(std::vector<std::shared_ptr<Gate<ShrType>>> gates, std::size_t window)
+    : gates_(std::move(gates)), window_(std::max<std::size_t>(window, 1)), released_(gates_.size(), false),
+      thread_([this] { run(); }) {
+    // position_ is only used by the online phase, so it can be filled after the thread started
+    std::lock_guard lock(mutex_);
+    for (std::size_t i = 0; i < gates_.size(); ++i) {
+        position_.emplace(gates_[i].get(), i);
+    }
+}
+
+
+template <IsSpdz2kShare ShrType>
+PreprocessingStream<ShrType>::~PreprocessingStream() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+
+template <IsSpdz2kShare ShrType>
+void PreprocessingStream<ShrType>::run() {
+    for (std::size_t i = 0; i < gates_.size(); ++i) {
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this, i] { return stop_ || num_in_window_ < window_ || num_wanted_ > i; });
+            if (stop_)
+                return;
+        }
+
+        try {
+            gates_[i]->readOwnOfflineFromFile();
+        } catch (...) {
+            std::lock_guard lock(mutex_);
+            error_ = std::current_exception();
+            cv_.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            ++num_read_;
+            ++num_in_window_;
+        }
+        cv_.notify_all();
+    }
+}
+
+
+template <IsSpdz2kShare ShrType>
+void PreprocessingStream<ShrType>::waitFor(const Gate<ShrType>* gate) {
+    std::unique_lock lock(mutex_);
+    auto it = position_.find(gate);
+    if (it == position_.end())
+        return; // its data were read before streaming started
+
+    auto position = it->second;
+    if (num_wanted_ <= position) {
+        num_wanted_ = position + 1;
+        cv_.notify_all();
+    }
+    cv_.wait(lock, [this, position] { return num_read_ > position || error_; });
+    if (num_read_ <= position) {
+        std::rethrow_exception(error_);
+    }
+}
+
+
+template <IsSpdz2kShare ShrType>
+void PreprocessingStream<ShrType>::release(const Gate<ShrType>* gate) {
+    {
+        std::lock_guard lock(mutex_);
+        auto it = position_.find(gate);
+        if (it == position_.end() || it->second >= num_read_ || released_[it->second])
+            return;
+        released_[it->second] = true;
+        --num_in_window_;
+    }
+    cv_.notify_all();
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_PREPROCESSINGSTREAM_H
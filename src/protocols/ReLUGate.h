@@ -46,6 +46,7 @@ template <IsSpdz2kShare ShrType>
 void ReLUGate<ShrType>::doReadOfflineFromFile() {
     circuit_.readOfflineFromFile();
     this->lambda_shr() = this->circuit_.endpoints()[0]->lambda_shr();
+    this->lambda_shr_mac() = this->circuit_.endpoints()[0]->lambda_shr_mac();
 }
 
 template <IsSpdz2kShare ShrType>
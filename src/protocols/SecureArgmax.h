@@ -0,0 +1,93 @@
+#ifndef BIOAUTH_SECUREARGMAX_H
+#define BIOAUTH_SECUREARGMAX_H
+
+#include <memory>
+#include <vector>
+#include <numeric>
+#include <cstddef>
+#include <stdexcept>
+
+namespace bioauth {
+
+/// The maximum of the entries of a matrix and the index of an entry that attains it, both secret-shared.
+///
+/// A tournament whose layers are vectorized: with n candidates left, candidate i plays candidate i + n/2
+/// for all i < n/2 at once (an odd one out plays itself), so there are ceil(log2(n)) layers.
+/// In each layer
+///     d = first - second,  c = [d >= 0] (GtzGate),
+///     max = second + c * d,  index = index_second + c * (index_first - index_second),
+/// which costs one batched comparison and one round of element-wise multiplications.
+/// The comparison is correct as long as the differences of the entries fit in k - 1 bits.
+///
+/// The gates are added to the given circuit, which may be a Circuit or a FakeCircuit, so that the fake offline phase
+/// builds the same gates, e.g.,
+///     SecureArgmax argmax(circuit, scores);
+///     circuit.addEndpoint(circuit.output(argmax.max()));
+template <class CircuitType>
+class SecureArgmax {
+public:
+    using ClearType = typename CircuitType::ClearType;
+    using GatePtr = std::shared_ptr<typename CircuitType::GateType>;
+
+    SecureArgmax(CircuitType& circuit, const GatePtr& input);
+
+    /// A 1 x 1 wire with the maximum
+    [[nodiscard]] const GatePtr& max() const { return max_; }
+
+    /// A 1 x 1 wire with the index of the maximum in the input (in row-major order)
+    [[nodiscard]] const GatePtr& index() const { return index_; }
+
+    /// The number of tournament layers
+    [[nodiscard]] std::size_t num_layers() const { return num_layers_; }
+
+private:
+    GatePtr max_;
+    GatePtr index_;
+    std::size_t num_layers_ = 0;
+};
+
+
+template <class CircuitType>
+SecureArgmax<CircuitType>::SecureArgmax(CircuitType& circuit, const GatePtr& input) {
+    auto num_candidates = input->dim_row() * input->dim_col();
+    if (num_candidates == 0) {
+        throw std::invalid_argument("The input of SecureArgmax should not be empty");
+    }
+
+    std::vector<ClearType> positions(num_candidates);
+    std::iota(positions.begin(), positions.end(), ClearType{0});
+    GatePtr values = input;
+    GatePtr indices = circuit.constant(1, num_candidates, positions);
+
+    while (num_candidates > 1) {
+        // Entry i of the first half plays entry i of the second half, an odd one out plays itself
+        const auto half = num_candidates / 2;
+        std::vector<std::size_t> first(half), second(half);
+        std::iota(first.begin(), first.end(), std::size_t{0});
+        std::iota(second.begin(), second.end(), half);
+        if (num_candidates % 2 == 1) {
+            first.push_back(num_candidates - 1);
+            second.push_back(num_candidates - 1);
+        }
+
+        GatePtr first_values = circuit.gather(values, first);
+        GatePtr second_values = circuit.gather(values, second);
+        GatePtr diff = circuit.subtract(first_values, second_values);
+        GatePtr first_wins = circuit.gtz(diff);
+        values = circuit.add(second_values, circuit.elementMultiply(first_wins, diff));
+
+        GatePtr second_indices = circuit.gather(indices, second);
+        GatePtr index_diff = circuit.subtract(circuit.gather(indices, first), second_indices);
+        indices = circuit.add(second_indices, circuit.elementMultiply(first_wins, index_diff));
+
+        num_candidates = first.size();
+        ++num_layers_;
+    }
+
+    max_ = values;
+    index_ = indices;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_SECUREARGMAX_H
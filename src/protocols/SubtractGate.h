@@ -20,6 +20,8 @@ public:
     SubtractGate(const std::shared_ptr<Gate<ShrType>>& p_input_x,
                  const std::shared_ptr<Gate<ShrType>>& p_input_y);
 
+    [[nodiscard]] OnlineKind onlineKind() const override { return OnlineKind::kLocal; }
+
 private:
     void doReadOfflineFromFile() override;
     void doRunOnline() override;
@@ -41,7 +43,11 @@ SubtractGate(const std::shared_ptr<Gate<ShrType>>& p_input_x,
 
 
 template <IsSpdz2kShare ShrType>
-void SubtractGate<ShrType>::doReadOfflineFromFile() {} // do nothing
+void SubtractGate<ShrType>::doReadOfflineFromFile() {
+    auto size = this->dim_row() * this->dim_col();
+    this->lambda_shr() = this->party().ReadShares(size);
+    this->lambda_shr_mac() = this->party().ReadShares(size);
+}
 
 
 template <IsSpdz2kShare ShrType>
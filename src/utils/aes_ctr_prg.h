@@ -0,0 +1,92 @@
+/// @file
+/// A pseudo-random generator that expands a 128-bit seed with AES-128 in counter mode
+
+#ifndef BIOAUTH_AES_CTR_PRG_H
+#define BIOAUTH_AES_CTR_PRG_H
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <concepts>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <openssl/evp.h>
+
+#include "utils/rand.h"
+
+namespace bioauth {
+
+/// The output is the AES-CTR key stream under the seed (with a zero IV),
+/// so two generators with the same seed produce the same stream however it is split into calls.
+class AesCtrPrg {
+public:
+    using Seed = std::array<uint8_t, 16>;
+
+    explicit AesCtrPrg(const Seed& seed);
+
+    AesCtrPrg(const AesCtrPrg&) = delete;
+    AesCtrPrg& operator=(const AesCtrPrg&) = delete;
+
+    ~AesCtrPrg() { EVP_CIPHER_CTX_free(ctx_); }
+
+    /// Fill the buffer with the next size bytes of the stream
+    void fill(void* buffer, std::size_t size);
+
+    /// Returns the next num_elements values of the stream
+    template <std::integral T>
+    std::vector<T> next(std::size_t num_elements) {
+        std::vector<T> values(num_elements);
+        fill(values.data(), num_elements * sizeof(T));
+        return values;
+    }
+
+    /// A fresh random seed
+    static Seed randomSeed() {
+        Seed seed;
+        for (std::size_t i = 0; i < seed.size(); i += sizeof(uint64_t)) {
+            auto word = getRand<uint64_t>();
+            std::memcpy(seed.data() + i, &word, sizeof(word));
+        }
+        return seed;
+    }
+
+private:
+    EVP_CIPHER_CTX* ctx_;
+};
+
+
+inline
+AesCtrPrg::AesCtrPrg(const Seed& seed) : ctx_(EVP_CIPHER_CTX_new()) {
+    const uint8_t iv[16] = {};
+    if (ctx_ == nullptr || EVP_EncryptInit_ex(ctx_, EVP_aes_128_ctr(), nullptr, seed.data(), iv) != 1) {
+        EVP_CIPHER_CTX_free(ctx_);
+        throw std::runtime_error("Failed to initialize AES-CTR");
+    }
+}
+
+
+inline
+void AesCtrPrg::fill(void* buffer, std::size_t size) {
+    // The key stream is the encryption of zeros
+    auto* out = static_cast<uint8_t*>(buffer);
+    std::memset(out, 0, size);
+
+    constexpr std::size_t kMaxChunk = INT_MAX / 2;
+    while (size > 0) {
+        auto chunk = std::min(size, kMaxChunk);
+        int out_len = 0;
+        if (EVP_EncryptUpdate(ctx_, out, &out_len, out, static_cast<int>(chunk)) != 1) {
+            throw std::runtime_error("AES-CTR encryption failed");
+        }
+        out += chunk;
+        size -= chunk;
+    }
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_AES_CTR_PRG_H
@@ -0,0 +1,79 @@
+/// @file
+/// Bit-sliced layout of vectors of integers: plane t holds bit t of all the elements, 64 elements per word,
+/// so that a bitwise operation on all the elements is a loop over words.
+
+#ifndef BIOAUTH_BIT_SLICE_H
+#define BIOAUTH_BIT_SLICE_H
+
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace bioauth {
+
+/// Number of words of a plane of num_elements bits
+inline
+std::size_t numBitSliceWords(std::size_t num_elements) {
+    return (num_elements + 63) / 64;
+}
+
+/// Transposes the 64x64 bit matrix whose row i is a[i] (bit j of a[i] is column j)
+inline
+void transpose64(uint64_t a[64]) {
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (unsigned j = 32; j != 0; j >>= 1, mask ^= (mask << j)) {
+        for (unsigned k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = ((a[k] >> j) ^ a[k | j]) & mask;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+}
+
+/// The low num_bits bits of the values as num_bits planes, plane t starts at word t * numBitSliceWords(size).
+/// Bit i of word w of a plane belongs to values[64 * w + i], the bits past the last value are 0.
+template <std::unsigned_integral T>
+std::vector<uint64_t> bitSlice(std::span<const T> values, std::size_t num_bits) {
+    const auto num_words = numBitSliceWords(values.size());
+    std::vector<uint64_t> planes(num_bits * num_words);
+    uint64_t block[64];
+    for (std::size_t w = 0; w < num_words; ++w) {
+        const auto first = 64 * w;
+        const auto count = std::min<std::size_t>(64, values.size() - first);
+        for (std::size_t i = 0; i < 64; ++i) {
+            block[i] = i < count ? static_cast<uint64_t>(values[first + i]) : 0;
+        }
+        transpose64(block);
+        for (std::size_t t = 0; t < num_bits; ++t) {
+            planes[t * num_words + w] = block[t];
+        }
+    }
+    return planes;
+}
+
+/// The first num_elements bits of a plane, packed 8 per byte (bit j of byte b belongs to element 8 * b + j)
+inline
+std::vector<uint8_t> planeToBytes(std::span<const uint64_t> plane, std::size_t num_elements) {
+    std::vector<uint8_t> bytes((num_elements + 7) / 8);
+    for (std::size_t b = 0; b < bytes.size(); ++b) {
+        bytes[b] = static_cast<uint8_t>(plane[b / 8] >> (8 * (b % 8)));
+    }
+    return bytes;
+}
+
+/// The inverse of planeToBytes
+inline
+std::vector<uint64_t> bytesToPlane(std::span<const uint8_t> bytes) {
+    std::vector<uint64_t> plane((bytes.size() + 7) / 8);
+    for (std::size_t b = 0; b < bytes.size(); ++b) {
+        plane[b / 8] |= static_cast<uint64_t>(bytes[b]) << (8 * (b % 8));
+    }
+    return plane;
+}
+
+} // namespace bioauth
+
+#endif //BIOAUTH_BIT_SLICE_H
@@ -11,6 +11,8 @@
 
 #include <Eigen/Core>
 
+#include "utils/ring_gemm.h"
+
 namespace bioauth {
 
 // For matrix addtion, subtraction, and scalar product, we can use
@@ -25,7 +27,9 @@ namespace bioauth {
 // on Linux gcc and Windows MinGW gcc, but not on macOS Apple Clang.
 // so we detect it using macros to avoid compilation errors on macOS.
 //
-// For matrix multiplication, we use Eigen's implementation.
+// For matrix multiplication, we use our own kernels in ring_gemm.h,
+// because Eigen's generic integer product is not vectorized for 64/128-bit words.
+// Eigen's implementation is kept as matrixMultiplyEigen for reference and benchmarking.
 //
 // WARNING:
 // To improve efficiency, the dimensions are not checked in these functions,
@@ -125,6 +129,16 @@ void matrixScalarAssign(std::vector<T>& x, T scalar) {
 }
 
 
+// output[i] = x[indices[i]]
+template <std::integral T>
+inline
+std::vector<T> gatherVector(const std::vector<T>& x, const std::vector<std::size_t>& indices) {
+    std::vector<T> output(indices.size());
+    std::transform(indices.begin(), indices.end(), output.begin(), [&x](std::size_t i) { return x[i]; });
+    return output;
+}
+
+
 template <std::integral T>
 inline
 std::vector<T> matrixElemMultiply(std::vector<T>& x, std::vector<T>& y) {
@@ -143,8 +157,8 @@ std::vector<T> matrixElemMultiply(std::vector<T>& x, std::vector<T>& y) {
 
 template <std::integral T>
 inline
-void matrixMultiply(const T* lhs, const T* rhs, T* output,
-                    std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
+void matrixMultiplyEigen(const T* lhs, const T* rhs, T* output,
+                         std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
     using MatrixType = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
     Eigen::Map<const MatrixType> matrix_lhs(lhs, dim_row, dim_mid);
@@ -155,6 +169,14 @@ void matrixMultiply(const T* lhs, const T* rhs, T* output,
 }
 
 
+template <std::integral T>
+inline
+void matrixMultiply(const T* lhs, const T* rhs, T* output,
+                    std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
+    ringGemm(lhs, rhs, output, dim_row, dim_mid, dim_col);
+}
+
+
 template <std::integral T>
 inline
 std::vector<T> matrixMultiply(const std::vector<T>& lhs, const std::vector<T>& rhs,
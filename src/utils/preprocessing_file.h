@@ -0,0 +1,479 @@
+/// @file
+/// A versioned binary container for preprocessing data, and its writer and (memory-mapped) reader.
+
+#ifndef BIOAUTH_PREPROCESSING_FILE_H
+#define BIOAUTH_PREPROCESSING_FILE_H
+
+#include <bit>
+#include <span>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <concepts>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "utils/aes_ctr_prg.h"
+
+namespace bioauth {
+
+// Layout of a preprocessing file:
+//
+//   FileHeader                  magic, version
+//   (SectionHeader, payload)*   payload = count little-endian words of width bytes,
+//                               padded to kSectionAlignment so every payload can be viewed in place
+//   SectionHeader{kEnd}         count = number of sections
+//   uint64_t checksum           over all payloads, followed by padding
+//
+// A section is what one Write* call of the fake party produces, e.g., the [a] shares of a multiplication gate.
+// The reader does not require a read to match a section: it converts between widths
+// (narrowing or zero-extending, like reading the text format into another type does)
+// and continues into the next section when needed.
+//
+// Uniformly random shares need not be stored: a kSeed section holds the seed of an AesCtrPrg,
+// and the values of the following kSeededShares sections (which only consist of their header)
+// are the next values of its stream, expanded when they are read.
+
+static_assert(std::endian::native == std::endian::little,
+              "The preprocessing files are little-endian, big-endian hosts are not supported");
+
+enum class SectionKind : uint32_t {
+    kEnd = 0,
+    kKey = 1,      // share of the MAC key
+    kShares = 2,   // shares of values or MACs
+    kClear = 3,    // values known in clear by the party
+    kSeed = 4,     // seed of the generator of the kSeededShares sections
+    kSeededShares = 5, // shares taken from the generator, no payload
+};
+
+struct PreprocessingFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+struct PreprocessingSectionHeader {
+    uint32_t kind;
+    uint32_t width; // in bytes
+    uint64_t count;
+};
+
+constexpr char kPreprocessingMagic[8] = {'B', 'I', 'O', 'A', 'P', 'R', 'E', 'P'};
+constexpr uint32_t kPreprocessingVersion = 1;
+constexpr std::size_t kSectionAlignment = 16;
+
+static_assert(sizeof(PreprocessingFileHeader) == 16);
+static_assert(sizeof(PreprocessingSectionHeader) == 16);
+
+
+inline
+std::size_t paddingTo(std::size_t size, std::size_t alignment) {
+    return (alignment - size % alignment) % alignment;
+}
+
+
+/// Fold the bytes into a 64-bit checksum, one word at a time.
+/// It only guards against truncated or corrupted files, it is not cryptographic.
+inline
+uint64_t checksumUpdate(uint64_t checksum, const std::byte* data, std::size_t size) {
+    constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ULL;
+
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        checksum = std::rotl(checksum ^ word, 29) * kMultiplier;
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, size - i);
+        checksum = std::rotl(checksum ^ word, 29) * kMultiplier;
+    }
+    return checksum;
+}
+
+
+class PreprocessingWriter {
+public:
+    explicit PreprocessingWriter(const std::filesystem::path& path);
+
+    PreprocessingWriter(const PreprocessingWriter&) = delete;
+    PreprocessingWriter& operator=(const PreprocessingWriter&) = delete;
+
+    ~PreprocessingWriter() { close(); }
+
+    /// Write the values as a new section, each value takes sizeof(T) bytes
+    template <std::integral T>
+    void write(SectionKind kind, std::span<const T> values);
+
+    template <std::integral T>
+    void write(SectionKind kind, const std::vector<T>& values) { write(kind, std::span<const T>(values)); }
+
+    /// Write a section of num_elements values of type T that the reader takes from the seeded generator
+    template <std::integral T>
+    void writeSeeded(std::size_t num_elements);
+
+    /// Write the trailer, further writes are not allowed
+    void close();
+
+    /// Number of bytes of the payloads written so far
+    [[nodiscard]] std::size_t payload_bytes() const { return payload_bytes_; }
+
+private:
+    void writeRaw(const void* data, std::size_t size);
+    void writePadding(std::size_t size);
+
+    std::ofstream output_;
+    uint64_t checksum_ = 0;
+    uint64_t num_sections_ = 0;
+    std::size_t payload_bytes_ = 0;
+    bool closed_ = false;
+};
+
+
+inline
+PreprocessingWriter::PreprocessingWriter(const std::filesystem::path& path)
+    : output_(path, std::ios::binary | std::ios::trunc) {
+    if (!output_) {
+        throw std::runtime_error("Cannot open preprocessing file " + path.string() + " for writing");
+    }
+
+    PreprocessingFileHeader header{};
+    std::memcpy(header.magic, kPreprocessingMagic, sizeof(header.magic));
+    header.version = kPreprocessingVersion;
+    writeRaw(&header, sizeof(header));
+}
+
+
+template <std::integral T>
+void PreprocessingWriter::write(SectionKind kind, std::span<const T> values) {
+    if (closed_) {
+        throw std::logic_error("The preprocessing file is already closed");
+    }
+
+    PreprocessingSectionHeader header{static_cast<uint32_t>(kind), sizeof(T), values.size()};
+    writeRaw(&header, sizeof(header));
+
+    auto size = values.size_bytes();
+    writeRaw(values.data(), size);
+    writePadding(paddingTo(size, kSectionAlignment));
+
+    checksum_ = checksumUpdate(checksum_, reinterpret_cast<const std::byte*>(values.data()), size);
+    payload_bytes_ += size;
+    ++num_sections_;
+}
+
+
+template <std::integral T>
+void PreprocessingWriter::writeSeeded(std::size_t num_elements) {
+    if (closed_) {
+        throw std::logic_error("The preprocessing file is already closed");
+    }
+
+    PreprocessingSectionHeader header{static_cast<uint32_t>(SectionKind::kSeededShares), sizeof(T), num_elements};
+    writeRaw(&header, sizeof(header));
+    ++num_sections_;
+}
+
+
+inline
+void PreprocessingWriter::close() {
+    if (closed_)
+        return;
+
+    PreprocessingSectionHeader trailer{static_cast<uint32_t>(SectionKind::kEnd), 0, num_sections_};
+    writeRaw(&trailer, sizeof(trailer));
+    writeRaw(&checksum_, sizeof(checksum_));
+    writePadding(kSectionAlignment - sizeof(checksum_));
+    output_.close();
+    closed_ = true;
+}
+
+
+inline
+void PreprocessingWriter::writeRaw(const void* data, std::size_t size) {
+    output_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!output_) {
+        throw std::runtime_error("Failed to write the preprocessing file");
+    }
+}
+
+
+inline
+void PreprocessingWriter::writePadding(std::size_t size) {
+    constexpr char kZeros[kSectionAlignment] = {};
+    writeRaw(kZeros, size);
+}
+
+
+/// Reads a preprocessing file sequentially.
+/// The file is memory-mapped, so the values can be handed out as views without copying.
+class PreprocessingReader {
+public:
+    explicit PreprocessingReader(const std::filesystem::path& path);
+
+    PreprocessingReader(const PreprocessingReader&) = delete;
+    PreprocessingReader& operator=(const PreprocessingReader&) = delete;
+
+    ~PreprocessingReader();
+
+    /// Recompute the checksum of the whole file and compare it with the stored one
+    [[nodiscard]] bool verify() const;
+
+    /// Read the next num_elements values, converting them to T if they are stored with another width
+    template <std::integral T>
+    std::vector<T> read(std::size_t num_elements);
+
+    /// View the next num_elements values in place.
+    /// They must be stored with width sizeof(T) in a single section, otherwise std::runtime_error is thrown.
+    template <std::integral T>
+    std::span<const T> view(std::size_t num_elements);
+
+    /// Whether view<T>(num_elements) would succeed, values from the seeded generator can't be viewed
+    template <std::integral T>
+    [[nodiscard]] bool canView(std::size_t num_elements);
+
+private:
+    // Make sure the current section has values left, moving to the next section if needed
+    void ensureSection();
+    void checkRange(std::size_t offset, std::size_t size) const;
+
+    // Size of the payload stored in the file
+    static std::size_t payloadSize(const PreprocessingSectionHeader& header);
+
+    std::filesystem::path path_;
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    std::vector<std::byte> buffer_;
+#endif
+
+    std::size_t next_section_offset_ = sizeof(PreprocessingFileHeader);
+    const std::byte* section_data_ = nullptr;
+    uint32_t section_width_ = 0;
+    uint64_t section_remaining_ = 0;
+    bool section_seeded_ = false;
+    std::unique_ptr<AesCtrPrg> prg_;
+};
+
+
+inline
+PreprocessingReader::PreprocessingReader(const std::filesystem::path& path) : path_(path) {
+#ifdef _WIN32
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Cannot open preprocessing file " + path.string());
+    }
+    buffer_.resize(std::filesystem::file_size(path));
+    input.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open preprocessing file " + path.string());
+    }
+    struct stat file_stat{};
+    if (::fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat preprocessing file " + path.string());
+    }
+    size_ = static_cast<std::size_t>(file_stat.st_size);
+    void* mapped = size_ == 0 ? MAP_FAILED : ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Cannot map preprocessing file " + path.string());
+    }
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const std::byte*>(mapped);
+#endif
+
+    PreprocessingFileHeader header{};
+    checkRange(0, sizeof(header));
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, kPreprocessingMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path.string() + " is not a preprocessing file");
+    }
+    if (header.version != kPreprocessingVersion) {
+        throw std::runtime_error("Unsupported version " + std::to_string(header.version) +
+                                 " of preprocessing file " + path.string());
+    }
+}
+
+
+inline
+PreprocessingReader::~PreprocessingReader() {
+#ifndef _WIN32
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+#endif
+}
+
+
+inline
+void PreprocessingReader::checkRange(std::size_t offset, std::size_t size) const {
+    if (offset > size_ || size > size_ - offset) {
+        throw std::runtime_error("Preprocessing file " + path_.string() + " is truncated");
+    }
+}
+
+
+inline
+std::size_t PreprocessingReader::payloadSize(const PreprocessingSectionHeader& header) {
+    if (header.kind == static_cast<uint32_t>(SectionKind::kSeededShares))
+        return 0;
+    return static_cast<std::size_t>(header.count) * header.width;
+}
+
+
+inline
+bool PreprocessingReader::verify() const {
+    uint64_t checksum = 0;
+    uint64_t num_sections = 0;
+    std::size_t offset = sizeof(PreprocessingFileHeader);
+
+    while (true) {
+        PreprocessingSectionHeader header{};
+        checkRange(offset, sizeof(header));
+        std::memcpy(&header, data_ + offset, sizeof(header));
+        offset += sizeof(header);
+
+        if (header.kind == static_cast<uint32_t>(SectionKind::kEnd)) {
+            uint64_t stored_checksum;
+            checkRange(offset, sizeof(stored_checksum));
+            std::memcpy(&stored_checksum, data_ + offset, sizeof(stored_checksum));
+            return header.count == num_sections && stored_checksum == checksum;
+        }
+
+        auto size = payloadSize(header);
+        checkRange(offset, size);
+        checksum = checksumUpdate(checksum, data_ + offset, size);
+        offset += size + paddingTo(size, kSectionAlignment);
+        ++num_sections;
+    }
+}
+
+
+inline
+void PreprocessingReader::ensureSection() {
+    while (section_remaining_ == 0) {
+        PreprocessingSectionHeader header{};
+        checkRange(next_section_offset_, sizeof(header));
+        std::memcpy(&header, data_ + next_section_offset_, sizeof(header));
+
+        if (header.kind == static_cast<uint32_t>(SectionKind::kEnd)) {
+            throw std::runtime_error("Ran out of preprocessing data in " + path_.string());
+        }
+        if (header.width == 0 || header.width > sizeof(__uint128_t)) {
+            throw std::runtime_error("Invalid width in preprocessing file " + path_.string());
+        }
+
+        auto payload_offset = next_section_offset_ + sizeof(header);
+        auto size = payloadSize(header);
+        checkRange(payload_offset, size);
+        next_section_offset_ = payload_offset + size + paddingTo(size, kSectionAlignment);
+
+        if (header.kind == static_cast<uint32_t>(SectionKind::kSeed)) {
+            AesCtrPrg::Seed seed;
+            if (size != seed.size()) {
+                throw std::runtime_error("Invalid seed in preprocessing file " + path_.string());
+            }
+            std::memcpy(seed.data(), data_ + payload_offset, seed.size());
+            prg_ = std::make_unique<AesCtrPrg>(seed);
+            continue;
+        }
+        if (header.kind == static_cast<uint32_t>(SectionKind::kSeededShares) && !prg_) {
+            throw std::runtime_error("Seeded shares without a seed in preprocessing file " + path_.string());
+        }
+
+        section_seeded_ = header.kind == static_cast<uint32_t>(SectionKind::kSeededShares);
+        section_data_ = section_seeded_ ? nullptr : data_ + payload_offset;
+        section_width_ = header.width;
+        section_remaining_ = header.count;
+    }
+}
+
+
+template <std::integral T>
+std::vector<T> PreprocessingReader::read(std::size_t num_elements) {
+    std::vector<T> values(num_elements);
+
+    std::size_t done = 0;
+    while (done < num_elements) {
+        ensureSection();
+        auto n = static_cast<std::size_t>(std::min<uint64_t>(section_remaining_, num_elements - done));
+
+        if (section_width_ == sizeof(T)) {
+            if (section_seeded_) {
+                prg_->fill(values.data() + done, n * sizeof(T));
+            } else {
+                std::memcpy(values.data() + done, section_data_, n * sizeof(T));
+            }
+        }
+        else {
+            std::vector<std::byte> expanded;
+            const std::byte* source = section_data_;
+            if (section_seeded_) {
+                expanded.resize(n * section_width_);
+                prg_->fill(expanded.data(), expanded.size());
+                source = expanded.data();
+            }
+
+            // Little-endian, so copying the low bytes narrows and zero-filling widens
+            for (std::size_t i = 0; i < n; ++i) {
+                __uint128_t value = 0;
+                std::memcpy(&value, source + i * section_width_, section_width_);
+                values[done + i] = static_cast<T>(value);
+            }
+        }
+
+        if (!section_seeded_) {
+            section_data_ += n * section_width_;
+        }
+        section_remaining_ -= n;
+        done += n;
+    }
+
+    return values;
+}
+
+
+template <std::integral T>
+bool PreprocessingReader::canView(std::size_t num_elements) {
+    if (num_elements == 0)
+        return true;
+    ensureSection();
+    return !section_seeded_ && section_width_ == sizeof(T) && section_remaining_ >= num_elements;
+}
+
+
+template <std::integral T>
+std::span<const T> PreprocessingReader::view(std::size_t num_elements) {
+    if (!canView<T>(num_elements)) {
+        throw std::runtime_error("The requested values cannot be viewed in place in " + path_.string());
+    }
+    if (num_elements == 0)
+        return {};
+
+    std::span<const T> values(reinterpret_cast<const T*>(section_data_), num_elements);
+    section_data_ += num_elements * sizeof(T);
+    section_remaining_ -= num_elements;
+    return values;
+}
+
+} // namespace bioauth
+
+
+#endif //BIOAUTH_PREPROCESSING_FILE_H
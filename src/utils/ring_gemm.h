@@ -0,0 +1,376 @@
+/// @file
+
+#ifndef BIOAUTH_RING_GEMM_H
+#define BIOAUTH_RING_GEMM_H
+
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <execution>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BIOAUTH_RING_GEMM_X86
+#include <immintrin.h>
+#endif
+
+namespace bioauth {
+
+// Matrix multiplication over Z_{2^k}, where k is the bit width of T.
+//
+// Since the arithmetic wraps around, the product is just the integer product
+// computed with the native (modular) multiplication of T, so no reduction is needed.
+// The kernels are written for the shapes we meet in the protocols,
+// in particular the 1 x dim * dim x dbsize product of the authentication query:
+//
+// 1. The output is split into blocks of columns, the blocks are computed in parallel.
+// 2. Inside a block, the rhs is walked in tiles of kMidBlock rows, so that the tile
+//    is reused from cache by every row of the lhs.
+// 3. The innermost loop accumulates kUnroll rows of the tile into a row of the output,
+//    out[j] += a0 * r0[j] + ... + a3 * r3[j], so the output is loaded and stored once per kUnroll rows.
+//    It is vectorized with AVX-512 / AVX2 for 64-bit words, selected at runtime.
+// 4. For 128-bit words, the product is computed schoolbook on 64-bit limbs.
+//
+// When the rhs is a single column, every output element is a dot product instead,
+// which is parallelized along the shared dimension.
+//
+// fusedBeaverGemm computes all the products of MultiplyGate in one pass over the rhs operands.
+
+namespace ring_gemm_detail {
+
+template <std::integral T>
+constexpr std::size_t kColBlock = 16384 / sizeof(T); // output columns computed by a task, 16 KB of them
+constexpr std::size_t kMidBlock = 64; // rows of rhs in a tile
+constexpr std::size_t kUnroll = 4; // rows of rhs accumulated in one pass over the output
+constexpr std::size_t kParallelDot = 4096; // shorter dot products are not worth parallelizing
+
+
+/// The low 128 bits of x * y, computed schoolbook on 64-bit limbs.
+/// The high limbs only contribute to the upper half, so three 64-bit multiplications suffice.
+inline
+__uint128_t mulLow128(__uint128_t x, __uint128_t y) {
+    auto x_lo = static_cast<uint64_t>(x), x_hi = static_cast<uint64_t>(x >> 64);
+    auto y_lo = static_cast<uint64_t>(y), y_hi = static_cast<uint64_t>(y >> 64);
+
+    auto lo = static_cast<__uint128_t>(x_lo) * y_lo;
+    uint64_t cross = x_lo * y_hi + x_hi * y_lo;
+    return lo + (static_cast<__uint128_t>(cross) << 64);
+}
+
+
+template <std::integral T>
+inline
+T mulLow(T x, T y) {
+    if constexpr (sizeof(T) == 16)
+        return mulLow128(x, y);
+    else
+        return x * y;
+}
+
+
+/// out[j] += a[0] * rhs[j] + a[1] * rhs[stride + j] + a[2] * rhs[2 * stride + j] + a[3] * rhs[3 * stride + j]
+/// for j in [0, len), i.e., kUnroll rows of rhs are accumulated with one load and store of out.
+template <std::integral T>
+inline
+void axpy4(const T* a, const T* rhs, std::size_t stride, T* out, std::size_t len) {
+    const T* r0 = rhs;
+    const T* r1 = rhs + stride;
+    const T* r2 = rhs + 2 * stride;
+    const T* r3 = rhs + 3 * stride;
+    if constexpr (sizeof(T) == 16) {
+        // Schoolbook on 64-bit limbs, the cross terms only affect the upper limb,
+        // so they are summed in 64 bits and shifted once per output
+        uint64_t a_lo[kUnroll], a_hi[kUnroll];
+        for (std::size_t t = 0; t < kUnroll; ++t) {
+            a_lo[t] = static_cast<uint64_t>(a[t]);
+            a_hi[t] = static_cast<uint64_t>(a[t] >> 64);
+        }
+        const T* rows[kUnroll] = {r0, r1, r2, r3};
+        for (std::size_t j = 0; j < len; ++j) {
+            __uint128_t lo = 0;
+            uint64_t cross = 0;
+            for (std::size_t t = 0; t < kUnroll; ++t) {
+                auto b = rows[t][j];
+                auto b_lo = static_cast<uint64_t>(b), b_hi = static_cast<uint64_t>(b >> 64);
+                lo += static_cast<__uint128_t>(a_lo[t]) * b_lo;
+                cross += a_lo[t] * b_hi + a_hi[t] * b_lo;
+            }
+            out[j] += lo + (static_cast<__uint128_t>(cross) << 64);
+        }
+    }
+    else {
+        for (std::size_t j = 0; j < len; ++j) {
+            out[j] += a[0] * r0[j] + a[1] * r1[j] + a[2] * r2[j] + a[3] * r3[j];
+        }
+    }
+}
+
+
+#ifdef BIOAUTH_RING_GEMM_X86
+
+// AVX2 has no 64-bit multiply-low, so it is emulated with 32-bit multiplications:
+// a * b mod 2^64 = a_lo * b_lo + ((a_hi * b_lo + a_lo * b_hi) << 32)
+__attribute__((target("avx2")))
+inline
+__m256i mulLo64Avx2(__m256i va, __m256i va_hi, __m256i vb) {
+    __m256i vb_hi = _mm256_srli_epi64(vb, 32);
+    __m256i lo = _mm256_mul_epu32(va, vb);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(va_hi, vb), _mm256_mul_epu32(va, vb_hi));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+
+__attribute__((target("avx2")))
+inline
+void axpy4Avx2(const uint64_t* a, const uint64_t* rhs, std::size_t stride, uint64_t* out, std::size_t len) {
+    __m256i va[kUnroll], va_hi[kUnroll];
+    for (std::size_t t = 0; t < kUnroll; ++t) {
+        va[t] = _mm256_set1_epi64x(static_cast<long long>(a[t]));
+        va_hi[t] = _mm256_srli_epi64(va[t], 32);
+    }
+
+    std::size_t j = 0;
+    for (; j + 4 <= len; j += 4) {
+        __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + j));
+        for (std::size_t t = 0; t < kUnroll; ++t) {
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + t * stride + j));
+            acc = _mm256_add_epi64(acc, mulLo64Avx2(va[t], va_hi[t], vb));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j), acc);
+    }
+    axpy4(a, rhs + j, stride, out + j, len - j);
+}
+
+
+__attribute__((target("avx512f,avx512dq")))
+inline
+void axpy4Avx512(const uint64_t* a, const uint64_t* rhs, std::size_t stride, uint64_t* out, std::size_t len) {
+    __m512i va[kUnroll];
+    for (std::size_t t = 0; t < kUnroll; ++t) {
+        va[t] = _mm512_set1_epi64(static_cast<long long>(a[t]));
+    }
+
+    std::size_t j = 0;
+    for (; j + 8 <= len; j += 8) {
+        __m512i acc = _mm512_loadu_si512(out + j);
+        for (std::size_t t = 0; t < kUnroll; ++t) {
+            __m512i vb = _mm512_loadu_si512(rhs + t * stride + j);
+            acc = _mm512_add_epi64(acc, _mm512_mullo_epi64(va[t], vb));
+        }
+        _mm512_storeu_si512(out + j, acc);
+    }
+    axpy4(a, rhs + j, stride, out + j, len - j);
+}
+
+#endif // BIOAUTH_RING_GEMM_X86
+
+
+using Axpy4_64 = void (*)(const uint64_t*, const uint64_t*, std::size_t, uint64_t*, std::size_t);
+
+/// Pick the widest 64-bit kernel supported by the running CPU, only once.
+inline
+Axpy4_64 selectAxpy4_64() {
+    static const Axpy4_64 kernel = [] () -> Axpy4_64 {
+#ifdef BIOAUTH_RING_GEMM_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+            return axpy4Avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return axpy4Avx2;
+#endif
+        return axpy4<uint64_t>;
+    }();
+    return kernel;
+}
+
+
+/// axpy4 with the fastest kernel available for T
+template <std::integral T>
+inline
+void axpy4Dispatch(const T* a, const T* rhs, std::size_t stride, T* out, std::size_t len) {
+    if constexpr (std::same_as<T, uint64_t>) {
+        selectAxpy4_64()(a, rhs, stride, out, len);
+    }
+    else {
+        axpy4(a, rhs, stride, out, len);
+    }
+}
+
+
+/// out[j] += sum_k a[k] * rhs[k * stride + j] for k in [0, num_rows)
+template <std::integral T>
+inline
+void axpyRows(const T* a, std::size_t num_rows, const T* rhs, std::size_t stride, T* out, std::size_t len) {
+    std::size_t k = 0;
+    for (; k + kUnroll <= num_rows; k += kUnroll) {
+        T coefficients[kUnroll];
+        for (std::size_t t = 0; t < kUnroll; ++t) {
+            coefficients[t] = a[k + t];
+        }
+        axpy4Dispatch(coefficients, rhs + k * stride, stride, out, len);
+    }
+    // The remaining rows go one at a time: stride 0 with zero coefficients re-reads the same row,
+    // which does not change the result
+    for (; k < num_rows; ++k) {
+        T coefficients[kUnroll] = {a[k]};
+        axpy4Dispatch(coefficients, rhs + k * stride, std::size_t(0), out, len);
+    }
+}
+
+
+/// Run f(col_begin, col_end) over blocks of kColBlock<T> columns, in parallel
+template <std::integral T, typename Func>
+inline
+void forEachColumnBlock(std::size_t dim_col, const Func& f) {
+    constexpr auto block_size = kColBlock<T>;
+    std::vector<std::size_t> blocks((dim_col + block_size - 1) / block_size);
+    std::iota(blocks.begin(), blocks.end(), std::size_t(0));
+
+    auto run_block = [&f, dim_col] (std::size_t block) {
+        auto col_begin = block * block_size;
+        f(col_begin, std::min(col_begin + block_size, dim_col));
+    };
+
+#ifdef _LIBCPP_HAS_NO_INCOMPLETE_PSTL
+    std::for_each(blocks.begin(), blocks.end(), run_block);
+#else
+    std::for_each(std::execution::par, blocks.begin(), blocks.end(), run_block);
+#endif
+}
+
+
+/// Compute the columns [col_begin, col_end) of output = lhs * rhs
+template <std::integral T>
+inline
+void gemmColumnBlock(const T* lhs, const T* rhs, T* output,
+                     std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col,
+                     std::size_t col_begin, std::size_t col_end) {
+    auto len = col_end - col_begin;
+
+    for (std::size_t i = 0; i < dim_row; ++i) {
+        std::fill_n(output + i * dim_col + col_begin, len, T(0));
+    }
+
+    for (std::size_t mid_begin = 0; mid_begin < dim_mid; mid_begin += kMidBlock) {
+        auto num_mid = std::min(kMidBlock, dim_mid - mid_begin);
+
+        for (std::size_t i = 0; i < dim_row; ++i) {
+            axpyRows(lhs + i * dim_mid + mid_begin, num_mid,
+                     rhs + mid_begin * dim_col + col_begin, dim_col,
+                     output + i * dim_col + col_begin, len);
+        }
+    }
+}
+
+
+/// output = lhs * rhs, when rhs is a single column
+template <std::integral T>
+inline
+void gemv(const T* lhs, const T* rhs, T* output, std::size_t dim_row, std::size_t dim_mid) {
+    for (std::size_t i = 0; i < dim_row; ++i) {
+        const T* lhs_row = lhs + i * dim_mid;
+#ifndef _LIBCPP_HAS_NO_INCOMPLETE_PSTL
+        if (dim_mid >= kParallelDot) {
+            output[i] = std::transform_reduce(std::execution::par_unseq, lhs_row, lhs_row + dim_mid, rhs, T(0),
+                                              std::plus<T>(), mulLow<T>);
+            continue;
+        }
+#endif
+        output[i] = std::transform_reduce(lhs_row, lhs_row + dim_mid, rhs, T(0),
+                                          std::plus<T>(), mulLow<T>);
+    }
+}
+
+} // namespace ring_gemm_detail
+
+
+/// Multiply two row-major matrices over Z_{2^k}, output = lhs * rhs
+/// @param lhs dim_row x dim_mid matrix
+/// @param rhs dim_mid x dim_col matrix
+/// @param output dim_row x dim_col matrix, must not alias the inputs
+template <std::integral T>
+inline
+void ringGemm(const T* lhs, const T* rhs, T* output,
+              std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
+    using namespace ring_gemm_detail;
+
+    if (dim_col == 1) {
+        gemv(lhs, rhs, output, dim_row, dim_mid);
+        return;
+    }
+
+    forEachColumnBlock<T>(dim_col, [=] (std::size_t col_begin, std::size_t col_end) {
+        gemmColumnBlock(lhs, rhs, output, dim_row, dim_mid, dim_col, col_begin, col_end);
+    });
+}
+
+
+/// The products of a Beaver multiplication of matrices, fused into a single pass:
+///
+///     xy    += x * y
+///     z     -= a * y + x * b
+///     z_mac -= a_mac * y + x * b_mac
+///
+/// y, b and b_mac are the large operands (dim_mid x dim_col), each of them is read once,
+/// and every product is accumulated in place, so no temporary matrices are allocated.
+/// x, a and a_mac are dim_row x dim_mid, the outputs are dim_row x dim_col.
+template <std::integral T>
+inline
+void fusedBeaverGemm(const T* x, const T* y,
+                     const T* a, const T* a_mac,
+                     const T* b, const T* b_mac,
+                     T* xy, T* z, T* z_mac,
+                     std::size_t dim_row, std::size_t dim_mid, std::size_t dim_col) {
+    using namespace ring_gemm_detail;
+
+    if (dim_col == 1) {
+        for (std::size_t i = 0; i < dim_row; ++i) {
+            T sum_xy(0), sum_z(0), sum_z_mac(0);
+            for (std::size_t k = 0; k < dim_mid; ++k) {
+                auto idx = i * dim_mid + k;
+                sum_xy += mulLow(x[idx], y[k]);
+                sum_z += mulLow(a[idx], y[k]) + mulLow(x[idx], b[k]);
+                sum_z_mac += mulLow(a_mac[idx], y[k]) + mulLow(x[idx], b_mac[k]);
+            }
+            xy[i] += sum_xy;
+            z[i] -= sum_z;
+            z_mac[i] -= sum_z_mac;
+        }
+        return;
+    }
+
+    forEachColumnBlock<T>(dim_col, [=] (std::size_t col_begin, std::size_t col_end) {
+        auto len = col_end - col_begin;
+        // Subtraction is addition of the negated coefficients in Z_{2^k}
+        T neg_x[kMidBlock], neg_a[kMidBlock], neg_a_mac[kMidBlock];
+
+        for (std::size_t mid_begin = 0; mid_begin < dim_mid; mid_begin += kMidBlock) {
+            auto num_mid = std::min(kMidBlock, dim_mid - mid_begin);
+            auto rhs_offset = mid_begin * dim_col + col_begin;
+
+            for (std::size_t i = 0; i < dim_row; ++i) {
+                auto lhs_offset = i * dim_mid + mid_begin;
+                auto out_offset = i * dim_col + col_begin;
+                for (std::size_t k = 0; k < num_mid; ++k) {
+                    neg_x[k] = -x[lhs_offset + k];
+                    neg_a[k] = -a[lhs_offset + k];
+                    neg_a_mac[k] = -a_mac[lhs_offset + k];
+                }
+
+                axpyRows(x + lhs_offset, num_mid, y + rhs_offset, dim_col, xy + out_offset, len);
+                axpyRows(neg_a, num_mid, y + rhs_offset, dim_col, z + out_offset, len);
+                axpyRows(neg_a_mac, num_mid, y + rhs_offset, dim_col, z_mac + out_offset, len);
+                axpyRows(neg_x, num_mid, b + rhs_offset, dim_col, z + out_offset, len);
+                axpyRows(neg_x, num_mid, b_mac + rhs_offset, dim_col, z_mac + out_offset, len);
+            }
+        }
+    });
+}
+
+} // namespace bioauth
+
+
+#endif //BIOAUTH_RING_GEMM_H